@@ -0,0 +1,120 @@
+#ifndef ANALYSISCACHE_HPP
+#define ANALYSISCACHE_HPP
+
+#include "StringScanner.hpp"
+#include "TextSearch.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+// Share of a block's bytes in each class, scaled to 0..255.
+struct ByteClassMix {
+    std::uint8_t zero;      // 0x00
+    std::uint8_t text;      // printable ASCII, tab, CR, LF
+    std::uint8_t control;   // other bytes below 0x80
+    std::uint8_t high;      // 0x80..0xFF
+};
+
+// On-disk sidecar of per-file analysis results, stored under ~/.cache/hexeditpro and
+// keyed by canonical path. When size and mtime still match, everything is served
+// straight from the mapped file. Otherwise the file is re-hashed in fixed blocks and
+// only results that touch a changed block are recomputed.
+class AnalysisCache {
+public:
+    static constexpr std::size_t kBlockSize = 64u << 10;
+
+    AnalysisCache() = default;
+    ~AnalysisCache();
+    AnalysisCache(const AnalysisCache&) = delete;
+    AnalysisCache& operator=(const AnalysisCache&) = delete;
+
+    // Maps the sidecar for `path` (if any) and reconciles it with `data`.
+    void attach(const std::string& path, const unsigned char* data, std::size_t n);
+    void detach();
+
+    // The in-memory buffer no longer matches the file on disk; results are
+    // reconciled lazily on next use and nothing is persisted until file_saved().
+    void mark_modified();
+    void file_saved(const std::string& path, const unsigned char* data, std::size_t n);
+    // The buffer was re-synced with the file, which was last modified at `mtime_ns`.
+    // Changed blocks are re-validated lazily as after an edit, but results may be
+    // persisted again once they are.
+    void file_reloaded(std::int64_t mtime_ns, bool contents_changed);
+
+    bool attached() const { return !m_path.empty(); }
+    bool was_fresh() const { return m_fresh; }
+    std::size_t dirty_blocks() const { return m_dirty_count; }
+
+    const std::vector<float>& block_entropy(const unsigned char* data, std::size_t n);
+    // The last computed mix; never reconciles, so drawing from it costs nothing.
+    // It comes from the entropy pass on attach and is kept current through
+    // update_classes(), which only re-histograms the blocks an edit touched.
+    const std::vector<ByteClassMix>& block_classes() const { return m_classes; }
+    void update_classes(const unsigned char* data, std::size_t n, std::size_t begin, std::size_t end);
+
+    // Returns true (and fills `out`) when cached strings for these options exist;
+    // blocks changed since they were computed are rescanned in place.
+    bool strings(const unsigned char* data, std::size_t n,
+                 const StringScanOptions& opts, std::vector<StringHit>& out);
+    void store_strings(const StringScanOptions& opts, const std::vector<StringHit>& hits);
+
+    // Same contract for literal search hit lists, keyed by pattern bytes.
+    bool search_hits(const unsigned char* data, std::size_t n,
+                     const std::vector<unsigned char>& pattern, std::vector<std::size_t>& out);
+    void store_search_hits(const std::vector<unsigned char>& pattern, const std::vector<std::size_t>& hits);
+
+    // And for TextSearch matches, keyed by TextSearch::key(). Hits around changed
+    // blocks are found again with the search itself.
+    bool text_search_hits(const unsigned char* data, std::size_t n,
+                          const TextSearch& search, std::vector<std::size_t>& out);
+    void store_text_search_hits(const TextSearch& search, const std::vector<std::size_t>& hits);
+
+    // Writes the sidecar if the buffer matches the file on disk.
+    bool persist();
+
+    static std::uint64_t hash_block(const unsigned char* p, std::size_t len);
+    static std::string sidecar_path(const std::string& canonical_path);
+
+private:
+    struct Header;
+    using HitLists = std::map<std::vector<unsigned char>, std::vector<std::size_t>>;
+
+    std::string m_path;
+    std::string m_sidecar;
+    std::uint64_t m_file_size{0};      // on disk, which for .gz/.xz/.zst is not the data size
+    std::int64_t m_mtime_ns{0};
+    std::uint64_t m_data_size{0};
+
+    // Read-only mapping of the previous sidecar (results computed in earlier sessions).
+    const unsigned char* m_map{nullptr};
+    std::size_t m_map_size{0};
+    const Header* m_header{nullptr};
+
+    // Checksums describe the contents every result below was computed against.
+    std::vector<std::uint64_t> m_checksums;
+    std::vector<float> m_entropy;
+    std::vector<ByteClassMix> m_classes;
+    std::size_t m_dirty_count{0};
+    bool m_fresh{false};                // sidecar matched size+mtime, nothing re-read
+    bool m_reconciled{false};
+    bool m_matches_disk{false};
+
+    // Results are either still in the mapping (valid while the file is unchanged)
+    // or owned here once they have been recomputed or repaired.
+    bool m_have_strings{false};
+    StringScanOptions m_string_opts;
+    std::vector<StringHit> m_strings;
+    HitLists m_searches;
+    HitLists m_text_searches;
+
+    bool map_sidecar();
+    void unmap();
+    bool stat_file(const std::string& path);
+    void reconcile(const unsigned char* data, std::size_t n);
+    bool mapped_strings(StringScanOptions& opts, std::vector<StringHit>& out) const;
+    void mapped_searches(std::uint32_t kind, HitLists& out) const;
+};
+
+#endif
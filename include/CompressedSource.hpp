@@ -0,0 +1,91 @@
+#ifndef COMPRESSEDSOURCE_HPP
+#define COMPRESSEDSOURCE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Decodes a .gz, .xz or .zst file without decompressing it to disk. The sequential
+// pass records decompression checkpoints: zran-style access points (bit offset plus
+// 32 KiB window) at deflate block boundaries for gzip, block starts for xz and
+// frame starts for zstd. They let a growing file resume from the last checkpoint
+// and let read_all() decode the spans between checkpoints in parallel.
+class CompressedSource {
+public:
+    enum class Format { None, Gzip, Xz, Zstd };
+
+    // Called with every decoded byte range in offset order.
+    using Sink = std::function<void(std::uint64_t offset, const unsigned char* p, std::size_t n)>;
+
+    static constexpr std::size_t kWindow = 32u << 10;
+    static constexpr std::uint64_t kSpacing = 4u << 20;    // min output between checkpoints
+
+    static Format detect(const std::string& path);
+    static const char* format_name(Format format);
+
+    bool open(const std::string& path);
+    Format format() const { return m_format; }
+    // A lower bound on the decoded size, read from the container without decoding:
+    // the gzip ISIZE trailer, the xz index of the last stream or the content size of
+    // the first zstd frame. 0 when the file does not record one.
+    std::uint64_t size_hint() const;
+
+    // Decodes from the last checkpoint (the start of the file the first time) to the
+    // current end of the compressed file, recording checkpoints along the way. A file
+    // still being written simply ends early; calling again later picks up from the
+    // last checkpoint. Safe to run on a worker thread.
+    bool index(const Sink& sink, const std::atomic<bool>* cancel = nullptr);
+    // Forgets all checkpoints (the file was rewritten).
+    void reset();
+
+    std::uint64_t size() const { return m_size.load(); }
+    std::size_t checkpoint_count() const;
+    std::size_t resident_bytes() const;
+    // True while the compressed file still has the size and mtime it was indexed at.
+    bool unchanged_on_disk() const;
+    std::uint64_t compressed_size() const { return m_disk_size; }
+
+    // Decodes [0,size()) into `out`, one checkpoint span per WorkerPool task.
+    bool read_all(unsigned char* out);
+
+private:
+    struct Checkpoint {
+        std::uint64_t out;                  // decoded offset
+        std::uint64_t in;                   // compressed offset to resume reading at
+        int bits;                           // gzip: unused bits of the byte before `in`
+        int check;                          // xz: integrity check of the enclosing stream
+        std::vector<unsigned char> window;  // gzip: the kWindow bytes before `out`
+    };
+
+    std::string m_path;
+    Format m_format{Format::None};
+    std::atomic<std::uint64_t> m_size{0};
+    std::uint64_t m_disk_size{0};
+    std::int64_t m_disk_mtime_ns{0};
+
+    // Checkpoints are only ever appended; a deque keeps references stable for
+    // readers decoding from one while the indexer adds more.
+    mutable std::mutex m_points_mutex;
+    std::deque<Checkpoint> m_points;
+
+    const Checkpoint* checkpoint_before(std::uint64_t offset) const;
+    void add_checkpoint(Checkpoint&& cp);
+
+    // Decodes from `from` (the file start when null) until `stop` decoded bytes
+    // (0 = until input runs out). `out_end` receives the decoded end offset.
+    bool decode(const Checkpoint* from, std::uint64_t stop, const Sink& sink, bool record,
+                const std::atomic<bool>* cancel, std::uint64_t& out_end);
+    bool decode_gzip(const Checkpoint* from, std::uint64_t stop, const Sink& sink, bool record,
+                     const std::atomic<bool>* cancel, std::uint64_t& out_end);
+    bool decode_xz(const Checkpoint* from, std::uint64_t stop, const Sink& sink, bool record,
+                   const std::atomic<bool>* cancel, std::uint64_t& out_end);
+    bool decode_zstd(const Checkpoint* from, std::uint64_t stop, const Sink& sink, bool record,
+                     const std::atomic<bool>* cancel, std::uint64_t& out_end);
+};
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef DATAINSPECTOR_HPP
+#define DATAINSPECTOR_HPP
+
+#include <gtkmm.h>
+#include "HexBuffer.hpp"
+#include "ValueDecoder.hpp"
+#include <array>
+#include <cstddef>
+
+// Shows the bytes at the cursor decoded as every common type, in both byte orders.
+// Cursor moves are coalesced so at most one decode runs per kMinIntervalMs, and
+// labels are only touched when their text actually changed.
+class DataInspector : public Gtk::Box {
+public:
+    DataInspector();
+    ~DataInspector() override;
+
+    void set_buffer(const HexBuffer* buffer);
+    void set_cursor(std::size_t offset);
+    void set_big_endian_first(bool big_first);
+
+private:
+    static constexpr int kMinIntervalMs = 40;
+
+    Gtk::Label m_offset_label;
+    Gtk::Grid m_grid;
+    Gtk::Label m_first_title;
+    Gtk::Label m_second_title;
+    std::array<Gtk::Label, ValueDecoder::kRowCount> m_names;
+    std::array<Gtk::Label, ValueDecoder::kRowCount> m_first;
+    std::array<Gtk::Label, ValueDecoder::kRowCount> m_second;
+
+    const HexBuffer* m_buffer{nullptr};
+    std::size_t m_offset{0};
+    bool m_big_first{false};
+    bool m_dirty{false};
+    gint64 m_last_refresh_us{0};
+    sigc::connection m_timer;
+
+    using TextColumn = std::array<std::array<char, ValueDecoder::kTextLen>, ValueDecoder::kRowCount>;
+
+    ValueDecoder::Values m_values;
+    TextColumn m_shown_first{};
+    TextColumn m_shown_second{};
+
+    void schedule();
+    bool on_timer();
+    void refresh();
+};
+
+#endif
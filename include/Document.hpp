@@ -0,0 +1,108 @@
+#ifndef DOCUMENT_HPP
+#define DOCUMENT_HPP
+
+#include <gtkmm.h>
+#include "AnalysisCache.hpp"
+#include "HexBuffer.hpp"
+#include "HexViewWidget.hpp"
+#include "MarkTree.hpp"
+#include "MemoryBudget.hpp"
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// One open file in its own tab: the bytes, their analysis cache and the hex view.
+// While a clean, file-backed document is not the active tab, the shared
+// MemoryBudget may release its bytes and rendered text; they are re-read from disk
+// when the tab is shown again. Compressed files are decoded on the shared
+// WorkerPool: open() returns at once and signal_loaded() reports the outcome.
+class Document {
+public:
+    Document();
+    ~Document();
+    Document(const Document&) = delete;
+    Document& operator=(const Document&) = delete;
+
+    HexBuffer buffer;
+    AnalysisCache cache;
+    HexViewWidget view;
+    Gtk::ScrolledWindow scroll;
+    Gtk::Label tab_label;
+
+    // Bookmarks and highlights, and the marks of the current search. Both follow
+    // inserts and deletes made through the view.
+    MarkTree marks;
+    MarkTree search_marks;
+    std::vector<std::string> bookmark_names;
+
+    bool open(const std::string& path);
+    bool loading() const { return m_loading; }
+    const std::string& loading_path() const { return m_loading_path; }
+    // Decoded bytes so far while loading(); emitted every few MiB.
+    sigc::signal<void, std::size_t>& signal_load_progress() { return m_signal_load_progress; }
+    // A background load finished (true) or failed (false); not emitted when cancelled.
+    sigc::signal<void, bool>& signal_loaded() { return m_signal_loaded; }
+    // Why the last background load failed, when there is more to say than that it did.
+    const std::string& load_error() const { return m_load_error; }
+    bool save(const std::string& path);
+
+    // Call once `buffer` has actually been changed; a failed edit must leave the tab clean.
+    void mark_modified();
+    bool modified() const { return m_modified; }
+
+    void add_bookmark(std::size_t offset, const std::string& name);
+    // Offset of the first bookmark called `name`.
+    bool find_bookmark(const std::string& name, std::size_t& offset) const;
+    void add_highlight(std::size_t begin, std::size_t end, std::uint32_t color);
+    void clear_marks(MarkKind kind);
+    bool empty() const {
+        return buffer.data.empty() && buffer.current_path.empty() && !m_released && !m_loading;
+    }
+
+    // Pulls in what changed on disk, re-rendering only the affected rows. Documents
+    // with unsaved edits are left alone (returns false); `grew` reports an append.
+    bool sync_from_disk(bool& grew);
+
+    // Reloads the file if the budget released it. Returns false if it can no longer be read.
+    bool ensure_resident();
+    bool released() const { return m_released; }
+    std::size_t resident_bytes() const;
+
+    // Marks this document as most recently used.
+    void touch();
+    MemoryBudget::Id budget_id() const { return m_budget_id; }
+
+private:
+    MemoryBudget::Id m_budget_id{0};
+    bool m_modified{false};
+    bool m_released{false};
+    std::size_t m_saved_cursor{0};
+
+    // Worker -> UI hand-off for a background decode
+    std::string m_loading_path;
+    std::string m_load_error;
+    bool m_loading{false};
+    std::future<void> m_decode_job;
+    std::atomic<bool> m_decode_cancel{false};
+    std::atomic<std::size_t> m_decoded_bytes{0};
+    std::mutex m_decode_mutex;
+    DecodedFile m_decoded;
+    bool m_decode_done{false};
+    bool m_decode_ok{false};
+    Glib::Dispatcher m_decode_dispatcher;
+    sigc::signal<void, std::size_t> m_signal_load_progress;
+    sigc::signal<void, bool> m_signal_loaded;
+
+    void update_classes(std::size_t begin, std::size_t end);
+    void cancel_load();
+    void on_decode_dispatch();
+    void finish_open(const std::string& path);
+
+    bool release();
+    void update_title();
+};
+
+#endif
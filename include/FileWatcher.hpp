@@ -0,0 +1,47 @@
+#ifndef FILEWATCHER_HPP
+#define FILEWATCHER_HPP
+
+#include <gtkmm.h>
+#include <map>
+#include <set>
+#include <string>
+
+// inotify watches on open files, serviced from the GTK main loop. Bursts of writes
+// are coalesced: signal_changed fires at most once per path per kSettleMs. Files
+// that are replaced (written elsewhere and renamed over) are re-watched by path.
+class FileWatcher {
+public:
+    static constexpr unsigned kSettleMs = 100;
+
+    FileWatcher();
+    ~FileWatcher();
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    // Reference counted, so two tabs on the same file can watch and unwatch independently.
+    bool watch(const std::string& path);
+    void unwatch(const std::string& path);
+
+    sigc::signal<void, const std::string&>& signal_changed() { return m_signal_changed; }
+
+private:
+    struct Watch {
+        int wd{-1};      // -1 while the file is missing
+        int refs{0};
+    };
+
+    int m_fd{-1};
+    std::map<std::string, Watch> m_watches;
+    std::map<int, std::string> m_paths;   // watch descriptor -> path
+    std::set<std::string> m_pending;
+
+    sigc::connection m_io;
+    sigc::connection m_settle;
+    sigc::signal<void, const std::string&> m_signal_changed;
+
+    bool add_watch(const std::string& path, Watch& w);
+    bool on_io(Glib::IOCondition cond);
+    bool on_settled();
+};
+
+#endif
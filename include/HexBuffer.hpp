@@ -1,17 +1,61 @@
 #ifndef HEXBUFFER_HPP
 #define HEXBUFFER_HPP
 
+#include "CompressedSource.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <vector>
 #include <string>
 
+struct ByteRange {
+    std::size_t begin;
+    std::size_t end;   // exclusive
+};
+
+// A compressed file decoded by HexBuffer::decode(), ready to be adopted.
+struct DecodedFile {
+    std::shared_ptr<CompressedSource> source;
+    std::vector<unsigned char> data;
+    std::int64_t mtime_ns = 0;
+    bool over_limit = false;   // decode() gave up because the data would not fit
+};
+
 class HexBuffer {
 public:
+    static constexpr std::size_t kReloadBlock = 64u << 10;
+
     std::vector<unsigned char> data;
     std::string current_path;
+    std::int64_t disk_mtime_ns = 0;   // of current_path when data last matched it
+    // Set when current_path is a .gz/.xz/.zst file; `data` holds the decoded bytes.
+    std::shared_ptr<CompressedSource> source;
 
     bool load(const std::string& path);
+
+    // The slow half of loading a .gz/.xz/.zst file. It touches no HexBuffer, so it
+    // can run on a worker; `progress` gets the decoded size so far. adopt() then
+    // installs the result on the UI thread. The whole file is decoded into memory,
+    // so a non-zero `limit` refuses it (over_limit) up front when the container
+    // records a larger size, and otherwise as soon as the output passes it.
+    static bool decode(const std::string& path, DecodedFile& out, const std::atomic<bool>* cancel = nullptr,
+                       const std::function<void(std::size_t)>& progress = {}, std::size_t limit = 0);
+    void adopt(const std::string& path, DecodedFile&& file);
+    // Compressed inputs are written back uncompressed, and never over their own path.
     bool save(const std::string& path);
     void clear();
+
+    // Re-reads current_path after `data` was dropped. A compressed file that has not
+    // changed is decoded in parallel from its seek index instead of from the start.
+    bool restore();
+
+    // Brings `data` up to date with current_path. The file is compared block by block,
+    // including when it grew, and only blocks that differ (plus any new tail) are
+    // copied. A growing compressed file is decoded from its last checkpoint.
+    // Changed ranges go into `changed`; false on I/O error.
+    bool reload_changes(std::vector<ByteRange>& changed);
 };
 
 #endif
@@ -0,0 +1,140 @@
+#ifndef HEXLAYOUT_HPP
+#define HEXLAYOUT_HPP
+
+#include <algorithm>
+#include <cstddef>
+
+// Row geometry of the hex pane: `bytes_per_line` bytes per row, printed in groups of
+// `group_size` bytes ("0011 2233 ..."). Every supported layout has a specialization
+// whose loops have constant trip counts, so the compiler fully unrolls row
+// formatting and turns the column math into shifts; set() picks the matching one.
+namespace hexlayout {
+
+inline constexpr char kHexDigits[] = "0123456789ABCDEF";
+
+template <std::size_t Bytes, std::size_t Group>
+struct Fixed {
+    static_assert(Group > 0 && Bytes % Group == 0, "group must divide the row");
+
+    static constexpr std::size_t kGroupChars = Group * 2 + 1;
+    static constexpr std::size_t kLineChars = (Bytes / Group) * kGroupChars - 1;
+
+    static std::size_t column(std::size_t byte_in_line) {
+        return (byte_in_line / Group) * kGroupChars + (byte_in_line % Group) * 2;
+    }
+
+    static std::size_t byte_at(std::size_t col) {
+        const std::size_t within = std::min<std::size_t>((col % kGroupChars) / 2, Group - 1);
+        return std::min<std::size_t>((col / kGroupChars) * Group + within, Bytes - 1);
+    }
+
+    // Writes one full row of kLineChars characters (no newline); returns the end.
+    static char* format_hex(const unsigned char* p, char* out) {
+        for (std::size_t i = 0; i < Bytes; ++i) {
+            *out++ = kHexDigits[p[i] >> 4];
+            *out++ = kHexDigits[p[i] & 0x0F];
+            if (i % Group == Group - 1 && i != Bytes - 1) *out++ = ' ';
+        }
+        return out;
+    }
+
+    static char* format_ascii(const unsigned char* p, char* out) {
+        for (std::size_t i = 0; i < Bytes; ++i)
+            *out++ = (p[i] >= 0x20 && p[i] < 0x7F) ? static_cast<char>(p[i]) : '.';
+        return out;
+    }
+};
+
+} // namespace hexlayout
+
+class HexLayout {
+public:
+    HexLayout() { set(16, 1); }
+
+    // Returns false (and keeps the current layout) for unsupported combinations.
+    bool set(std::size_t bytes_per_line, std::size_t group_size);
+
+    std::size_t bytes_per_line() const { return m_bytes; }
+    std::size_t group_size() const { return m_group; }
+    std::size_t hex_line_chars() const { return m_line_chars; }
+
+    std::size_t hex_column(std::size_t byte_in_line) const { return m_column(byte_in_line); }
+    std::size_t byte_from_hex_column(std::size_t col) const { return m_byte_at(col); }
+
+    char* format_hex_row(const unsigned char* p, char* out) const { return m_format_hex(p, out); }
+    char* format_ascii_row(const unsigned char* p, char* out) const { return m_format_ascii(p, out); }
+
+    // Trailing row with fewer than bytes_per_line() bytes, padded with spaces.
+    char* format_hex_partial(const unsigned char* p, std::size_t count, char* out) const;
+    char* format_ascii_partial(const unsigned char* p, std::size_t count, char* out) const;
+
+private:
+    std::size_t m_bytes{16};
+    std::size_t m_group{1};
+    std::size_t m_line_chars{47};
+
+    std::size_t (*m_column)(std::size_t){nullptr};
+    std::size_t (*m_byte_at)(std::size_t){nullptr};
+    char* (*m_format_hex)(const unsigned char*, char*){nullptr};
+    char* (*m_format_ascii)(const unsigned char*, char*){nullptr};
+
+    template <std::size_t Bytes, std::size_t Group>
+    void bind();
+};
+
+template <std::size_t Bytes, std::size_t Group>
+void HexLayout::bind() {
+    using L = hexlayout::Fixed<Bytes, Group>;
+    m_bytes = Bytes;
+    m_group = Group;
+    m_line_chars = L::kLineChars;
+    m_column = &L::column;
+    m_byte_at = &L::byte_at;
+    m_format_hex = &L::format_hex;
+    m_format_ascii = &L::format_ascii;
+}
+
+inline bool HexLayout::set(std::size_t bytes_per_line, std::size_t group_size) {
+    // Expands to one case per (row width, group size) pair.
+#define HEXLAYOUT_GROUPS(B)                                  \
+    case B:                                                  \
+        switch (group_size) {                                \
+        case 1: bind<B, 1>(); return true;                   \
+        case 2: bind<B, 2>(); return true;                   \
+        case 4: bind<B, 4>(); return true;                   \
+        case 8: bind<B, 8>(); return true;                   \
+        default: return false;                               \
+        }
+
+    switch (bytes_per_line) {
+        HEXLAYOUT_GROUPS(8)
+        HEXLAYOUT_GROUPS(16)
+        HEXLAYOUT_GROUPS(32)
+        HEXLAYOUT_GROUPS(64)
+    default:
+        return false;
+    }
+#undef HEXLAYOUT_GROUPS
+}
+
+inline char* HexLayout::format_hex_partial(const unsigned char* p, std::size_t count, char* out) const {
+    for (std::size_t i = 0; i < m_bytes; ++i) {
+        if (i < count) {
+            *out++ = hexlayout::kHexDigits[p[i] >> 4];
+            *out++ = hexlayout::kHexDigits[p[i] & 0x0F];
+        } else {
+            *out++ = ' ';
+            *out++ = ' ';
+        }
+        if (i % m_group == m_group - 1 && i != m_bytes - 1) *out++ = ' ';
+    }
+    return out;
+}
+
+inline char* HexLayout::format_ascii_partial(const unsigned char* p, std::size_t count, char* out) const {
+    for (std::size_t i = 0; i < m_bytes; ++i)
+        *out++ = i < count ? ((p[i] >= 0x20 && p[i] < 0x7F) ? static_cast<char>(p[i]) : '.') : ' ';
+    return out;
+}
+
+#endif
@@ -3,19 +3,36 @@
 
 #include <gtkmm.h>
 #include "HexBuffer.hpp"
+#include "HexLayout.hpp"
+#include "MarkTree.hpp"
+#include "OverviewBar.hpp"
+#include "StructTemplate.hpp"
+#include <array>
 #include <cstddef>
-#include <vector>
 #include <string>
+#include <utility>
+#include <vector>
 
 class HexViewWidget : public Gtk::Box {
 public:
     HexViewWidget();
 
     void update_display(const HexBuffer& buffer);
+    // Re-renders only the rows holding [begin,end) of `buffer`, plus any rows added
+    // or removed since the last render. Scroll position and cursor are kept.
+    void update_range(const HexBuffer& buffer, std::size_t begin, std::size_t end);
     void clear_display();
 
     void set_edit_mode(bool enable);
 
+    // Row width (8/16/32/64 bytes) and hex grouping (1/2/4/8 bytes). Returns false
+    // for unsupported combinations; the cursor byte is kept across the re-layout.
+    bool set_layout(std::size_t bytes_per_line, std::size_t group_size);
+    const HexLayout& layout() const { return m_layout; }
+
+    // Size of the rendered address/hex/ASCII text, for memory accounting.
+    std::size_t text_bytes() const { return m_text_bytes; }
+
     // --- Byte-level operations against HexBuffer, based on current selection ---
     bool get_selected_byte_range(std::size_t& start, std::size_t& end) const; // [start,end)
     bool copy_bytes_to_clipboard(const HexBuffer& buffer);
@@ -25,10 +42,40 @@ public:
     bool fill_selection(HexBuffer& buffer, unsigned char value);
     bool select_all();
 
-    void scroll_to_byte(std::size_t byte_index);
+    // Moves the cursor to `byte_index` and scrolls it into view; false if it lies
+    // past the rendered data. The row is found through the text buffer's line
+    // index, so the cost does not grow with the offset.
+    bool scroll_to_byte(std::size_t byte_index);
+    // Scrolls to `start` and selects [start,end) in both the hex and ASCII columns.
+    bool select_bytes(std::size_t start, std::size_t end);
+    std::size_t cursor_byte() const;
+
+    // Emitted whenever the synchronized cursor lands on a new byte.
+    sigc::signal<void, std::size_t>& signal_cursor_moved() { return m_signal_cursor_moved; }
+    // (offset, length) of bytes inserted or removed by cut / paste insert.
+    sigc::signal<void, std::size_t, std::size_t>& signal_bytes_inserted() { return m_signal_bytes_inserted; }
+    sigc::signal<void, std::size_t, std::size_t>& signal_bytes_erased() { return m_signal_bytes_erased; }
+    // (offset, length) of bytes rewritten in place by paste overwrite / fill.
+    sigc::signal<void, std::size_t, std::size_t>& signal_bytes_overwritten() { return m_signal_bytes_overwritten; }
+
+    // --- Bookmark / highlight / search-hit marks, queried for the visible rows on every scroll ---
+    void set_marks(const MarkTree* marks, const MarkTree* hits);
+    void refresh_marks() { refresh_mark_overlay(); }
+
+    // --- Whole-file minimap; `source` supplies the per-block byte class mix ---
+    void set_overview_source(OverviewBar::ClassSource source) { m_overview.set_source(std::move(source)); }
+    // The source's data changed; the minimap redraws from it.
+    void refresh_overview() { m_overview.queue_draw(); }
+
+    // --- Structure template overlay, decoded for the visible rows on every scroll ---
+    void set_template(const StructTemplate* tmpl, std::size_t base);
+    void clear_template();
 
 private:
-    static constexpr std::size_t kBytesPerLine = 16;
+    static constexpr std::size_t kOverlayCapacity = 4096;
+    static constexpr std::size_t kHighlightColors = 4;
+
+    HexLayout m_layout;
 
     Gtk::Paned m_paned_outer{Gtk::ORIENTATION_HORIZONTAL};
     Gtk::Paned m_paned_inner{Gtk::ORIENTATION_HORIZONTAL};
@@ -41,7 +88,33 @@ private:
     Gtk::TextView m_hex_view;
     Gtk::TextView m_ascii_view;
 
+    OverviewBar m_overview;
+
     bool m_syncing{false};
+    sigc::signal<void, std::size_t> m_signal_cursor_moved;
+    sigc::signal<void, std::size_t, std::size_t> m_signal_bytes_inserted;
+    sigc::signal<void, std::size_t, std::size_t> m_signal_bytes_erased;
+    sigc::signal<void, std::size_t, std::size_t> m_signal_bytes_overwritten;
+
+    const HexBuffer* m_buffer{nullptr};
+    std::size_t m_text_bytes{0};
+    std::size_t m_rendered_size{0};   // buffer size the text currently shows
+    std::size_t m_addr_digits{8};
+    const StructTemplate* m_template{nullptr};
+    std::size_t m_template_base{0};
+    std::vector<StructTemplate::Field> m_overlay_fields;
+    std::array<Glib::RefPtr<Gtk::TextTag>, StructTemplate::kColors> m_hex_tags;
+    std::array<Glib::RefPtr<Gtk::TextTag>, StructTemplate::kColors> m_ascii_tags;
+    int m_tagged_first_line{0};
+    int m_tagged_last_line{-1};
+
+    const MarkTree* m_marks{nullptr};
+    const MarkTree* m_hit_marks{nullptr};
+    std::vector<Mark> m_visible_marks;
+    std::vector<Glib::RefPtr<Gtk::TextTag>> m_mark_hex_tags;     // hit, highlights..., bookmark
+    std::vector<Glib::RefPtr<Gtk::TextTag>> m_mark_ascii_tags;
+    int m_marked_first_line{0};
+    int m_marked_last_line{-1};
 
     void setup_view(Gtk::TextView& tv, bool editable);
     void setup_sync();
@@ -60,6 +133,21 @@ private:
     static std::string bytes_to_hex_string(const std::vector<unsigned char>& bytes);
 
     void sync_cursors_from(Gtk::TextView* source);
+
+    void render();
+    void format_rows(std::size_t first, std::size_t last,
+                     std::string& addr, std::string& hex, std::string& ascii) const;
+    static std::size_t hex_digits(std::size_t v);
+
+    void setup_overlay_tags();
+    void visible_lines(Gtk::TextView& tv, int& first, int& last);
+    void refresh_template_overlay();
+    void refresh_mark_overlay();
+    void refresh_overlays();
+    void update_overview();
+    // Applies the tags to [begin,end) row by row; the caller clips to the visible rows.
+    void tag_bytes(const Glib::RefPtr<Gtk::TextTag>& hex_tag, const Glib::RefPtr<Gtk::TextTag>& ascii_tag,
+                   std::size_t begin, std::size_t end);
 };
 
 #endif
@@ -2,9 +2,15 @@
 #define MAINWINDOW_HPP
 
 #include <gtkmm.h>
-#include "HexBuffer.hpp"
-#include "HexViewWidget.hpp"
+#include "DataInspector.hpp"
+#include "Document.hpp"
+#include "FileWatcher.hpp"
+#include "SearchPanel.hpp"
+#include "StringsPanel.hpp"
+#include "TemplatePanel.hpp"
 #include "menu.h"
+#include <memory>
+#include <vector>
 
 class MainWindow : public Gtk::Window {
 public:
@@ -15,11 +21,25 @@ private:
     Gtk::Box m_vbox{Gtk::ORIENTATION_VERTICAL};
     Gtk::MenuBar m_menu_bar;
 
-    Gtk::ScrolledWindow m_scroll;
-    HexViewWidget m_hex_display;
+    Gtk::Paned m_main_paned{Gtk::ORIENTATION_HORIZONTAL};
+    Gtk::Notebook m_tabs;
+    sigc::connection m_tab_switched;
+
+    Gtk::Notebook m_side_panels;
+    StringsPanel m_strings_panel;
+    SearchPanel m_search_panel;
+    TemplatePanel m_template_panel;
+    DataInspector m_inspector;
 
     Gtk::Statusbar m_statusbar;
-    HexBuffer m_buffer;
+
+    // One per tab, in page order. The side panels are bound to m_active.
+    std::vector<std::unique_ptr<Document>> m_documents;
+    Document* m_active{nullptr};
+    FileWatcher m_watcher;
+    bool m_follow_tail{false};
+    std::uint32_t m_next_highlight{0};
+    std::string m_last_goto;
 
     Glib::RefPtr<Gtk::CssProvider> m_css_provider;
     bool m_dark_mode{false};
@@ -27,12 +47,23 @@ private:
     void setup_complex_menus();
     void apply_theme();
     void status(const std::string& msg);
+    void show_side_panel(Gtk::Widget& page);
+
+    // Tabs
+    Document& add_document();
+    void activate_document(Document& doc);
+    void bind_document(Document& doc);
+    void close_document(Document& doc);
+    void enforce_memory_budget();
+    void on_tab_switched(Gtk::Widget* page, guint page_num);
+    void on_file_changed(const std::string& path);
 
     // File
     void on_file_new();
     void on_file_open();
     void on_file_save();
     void on_file_save_as();
+    void on_file_close();
     void on_file_quit();
 
     // Edit
@@ -48,10 +79,32 @@ private:
 
     // View
     void on_view_theme_toggle();
+    void on_view_follow_tail();
+    void on_view_little_endian();
+    void on_view_big_endian();
+    void on_view_inspector();
+    void on_view_row_width(std::size_t bytes);
+    void on_view_group_size(std::size_t group);
 
     // Search / Analysis / Help
     void on_search_find_bytes();
+    void on_document_loaded(Document& doc, bool ok);
+    void on_search_find_text();
+    void on_search_goto();
+    void on_search_match_activated(std::size_t offset, std::size_t length);
+    void on_search_results_ready();
+    void on_search_add_bookmark();
+    void on_search_bookmark_step(bool forward);
+    void on_search_highlight_selection();
+    void on_search_clear_marks(MarkKind kind);
     void on_analysis_frequency();
+    void on_analysis_entropy();
+    void on_analysis_strings();
+    void on_string_activated(std::size_t offset);
+    void on_analysis_template();
+    void on_template_apply_requested();
+    void on_template_changed();
+    void on_template_field_activated(std::size_t offset);
     void on_help_about();
 };
 
@@ -0,0 +1,86 @@
+#ifndef MARKTREE_HPP
+#define MARKTREE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+enum class MarkKind : std::uint8_t { Bookmark, Highlight, SearchHit };
+
+struct Mark {
+    std::size_t begin;
+    std::size_t end;          // exclusive
+    MarkKind kind;
+    std::uint32_t tag;        // Bookmark: name index; Highlight: color index
+};
+
+// Byte-range marks kept in a treap ordered by `begin` and augmented with the
+// largest `end` of each subtree. Edits shift every mark after the edit point
+// through a lazy tag on one subtree, so inserts and deletes cost O(log n) plus
+// the marks that straddle the edit; overlap queries cost O(log n + hits). Nodes
+// live in one array, which keeps millions of search hits compact.
+class MarkTree {
+public:
+    MarkTree();
+
+    void insert(const Mark& mark);
+    // Removes one mark equal to `mark`; false if there is none.
+    bool erase(const Mark& mark);
+    // Replaces the contents with `marks`, which must be sorted by begin. O(n).
+    void assign(const std::vector<Mark>& marks);
+    void clear();
+
+    std::size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    std::size_t memory_bytes() const { return m_nodes.capacity() * sizeof(Node); }
+
+    // `len` bytes were inserted at `at`: marks at or after it move up, marks
+    // spanning it grow.
+    void on_insert(std::size_t at, std::size_t len);
+    // [at, at+len) was deleted: marks inside it vanish, marks after it move down,
+    // marks overlapping it shrink.
+    void on_erase(std::size_t at, std::size_t len);
+
+    // Appends every mark overlapping [begin,end), in begin order.
+    void query(std::size_t begin, std::size_t end, std::vector<Mark>& out) const;
+    // First mark starting after `pos` / last mark starting before it.
+    bool next_after(std::size_t pos, Mark& out) const;
+    bool prev_before(std::size_t pos, Mark& out) const;
+    // All marks in begin order.
+    void collect(std::vector<Mark>& out) const;
+
+private:
+    // begin/end/max_end exclude the shifts pending on this node and its ancestors;
+    // shifts add modulo 2^64, so a negative shift is just a large one.
+    struct Node {
+        Mark mark;
+        std::size_t max_end;
+        std::size_t shift;
+        std::uint32_t left;
+        std::uint32_t right;
+        std::uint32_t priority;
+    };
+
+    std::vector<Node> m_nodes;           // [0] is the nil sentinel
+    std::vector<std::uint32_t> m_free;
+    std::uint32_t m_root{0};
+    std::size_t m_size{0};
+    std::uint32_t m_seed{0x9E3779B9u};
+
+    std::uint32_t alloc(const Mark& mark);
+    void release(std::uint32_t n);
+    std::uint32_t random();
+
+    void push(std::uint32_t n);
+    void pull(std::uint32_t n);
+    void split(std::uint32_t t, std::size_t key, std::uint32_t& left, std::uint32_t& right);
+    std::uint32_t merge(std::uint32_t a, std::uint32_t b);
+    void take_all(std::uint32_t t, std::vector<Mark>& out);
+    void grow(std::uint32_t t, std::size_t at, std::size_t len);
+    void clip(std::uint32_t t, std::size_t at, std::size_t len);
+    void query(std::uint32_t t, std::size_t shift, std::size_t begin, std::size_t end,
+               std::vector<Mark>& out) const;
+    void collect(std::uint32_t t, std::size_t shift, std::vector<Mark>& out) const;
+};
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef MEMORYBUDGET_HPP
+#define MEMORYBUDGET_HPP
+
+#include <cstddef>
+#include <functional>
+#include <list>
+
+// One resident-memory limit shared by everything that holds file contents in RAM.
+// Holders register a callback reporting their resident size and one that tries to
+// drop it; enforce() releases least recently used holders until the total fits.
+// UI thread only, and callbacks must not call back into the budget.
+class MemoryBudget {
+public:
+    using Id = std::size_t;
+    using SizeFn = std::function<std::size_t()>;
+    using ReleaseFn = std::function<bool()>;   // false when the holder must stay resident
+
+    static MemoryBudget& shared();
+
+    // Defaults to a quarter of physical memory, at most 4 GiB; HEXEDITPRO_MEMORY_MB overrides.
+    MemoryBudget();
+
+    void set_limit(std::size_t bytes) { m_limit = bytes; }
+    std::size_t limit() const { return m_limit; }
+
+    Id add(SizeFn resident, ReleaseFn release);
+    void remove(Id id);
+    // Marks a holder as most recently used; it is released last.
+    void touch(Id id);
+
+    std::size_t resident() const;
+    // Releases idle holders, oldest first, until resident() <= limit(). `keep` is
+    // never released. Returns the number of bytes freed.
+    std::size_t enforce(Id keep = 0);
+
+private:
+    struct Holder {
+        Id id;
+        SizeFn resident;
+        ReleaseFn release;
+    };
+
+    std::list<Holder> m_lru;   // front = least recently used
+    std::size_t m_limit{0};
+    Id m_next_id{1};
+};
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef OFFSETEXPR_HPP
+#define OFFSETEXPR_HPP
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+struct OffsetContext {
+    const unsigned char* data = nullptr;
+    std::size_t size = 0;
+    std::size_t cursor = 0;
+    // Resolves a bookmark name to its offset.
+    std::function<bool(const std::string&, std::size_t&)> lookup;
+};
+
+// Evaluates a Go To expression such as `end-0x200`, `header+u32(0x3C)` or `+0x40`.
+//   numbers     0x1F00, 1F00h, 8000 (decimal)
+//   names       end (file size), cursor, or any bookmark name
+//   reads       u8 u16 u32 u64 with an optional le/be suffix (default le); bare they
+//               read at the cursor, `u32be(expr)` reads at expr
+//   operators   + - * / and parentheses; a leading + or - is relative to the cursor
+// Only the bytes a read names are touched, so evaluation cost does not depend on
+// the file size.
+class OffsetExpr {
+public:
+    static bool evaluate(const std::string& text, const OffsetContext& ctx, std::size_t& out, std::string& error);
+    // A bookmark name must be an identifier ([A-Za-z_][A-Za-z0-9_]*) that is not
+    // one of the built-in names or reads, or expressions could never reach it.
+    static bool valid_name(const std::string& name, std::string& error);
+};
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef OVERVIEWBAR_HPP
+#define OVERVIEWBAR_HPP
+
+#include <gtkmm.h>
+#include "AnalysisCache.hpp"
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+// Whole-file minimap beside the hex view. Each pixel row is a stacked bar of the
+// zero / text / control / high byte shares of its slice of the file, averaged from
+// AnalysisCache's per-block mix, so drawing never touches the bytes themselves.
+// The visible rows are outlined; clicking or dragging jumps to that offset.
+class OverviewBar : public Gtk::DrawingArea {
+public:
+    using ClassSource = std::function<const std::vector<ByteClassMix>&()>;
+
+    OverviewBar();
+
+    void set_source(ClassSource source);
+    void set_file_size(std::size_t size);
+    // Byte range currently shown by the hex view.
+    void set_viewport(std::size_t begin, std::size_t end);
+
+    sigc::signal<void, std::size_t>& signal_jump() { return m_signal_jump; }
+
+private:
+    ClassSource m_source;
+    std::size_t m_size{0};
+    std::size_t m_view_begin{0};
+    std::size_t m_view_end{0};
+    sigc::signal<void, std::size_t> m_signal_jump;
+
+    std::size_t offset_at(double y) const;
+    bool on_bar_draw(const Cairo::RefPtr<Cairo::Context>& cr);
+    bool on_bar_button_press(GdkEventButton* ev);
+    bool on_bar_motion(GdkEventMotion* ev);
+};
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef SEARCHPANEL_HPP
+#define SEARCHPANEL_HPP
+
+#include <gtkmm.h>
+#include "AnalysisCache.hpp"
+#include "HexBuffer.hpp"
+#include "TextSearch.hpp"
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <mutex>
+#include <vector>
+
+// Text / regex search over a HexBuffer (Search -> Find Text...). Like StringsPanel,
+// the search runs on the shared WorkerPool and streams hits in, and the list draws
+// only visible rows. Match lengths are not stored; they are recomputed per drawn row.
+class SearchPanel : public Gtk::Box {
+public:
+    SearchPanel();
+    ~SearchPanel() override;
+
+    void set_buffer(const HexBuffer* buffer);
+    void set_cache(AnalysisCache* cache) { m_cache = cache; }
+    void focus_query();
+    void start_search();
+
+    // Stops a running search and drops its results. Call before mutating the buffer.
+    void invalidate();
+
+    // Start offsets of the current results, ascending.
+    const std::vector<std::size_t>& hits() const { return m_hits; }
+    std::size_t match_length(std::size_t offset) const;
+
+    // offset, length of the clicked match
+    sigc::signal<void, std::size_t, std::size_t>& signal_match_activated() { return m_signal_match_activated; }
+    // A search finished (or was served from the cache); hits() is complete.
+    sigc::signal<void>& signal_results_ready() { return m_signal_results_ready; }
+
+private:
+    Gtk::Box m_query_row{Gtk::ORIENTATION_HORIZONTAL};
+    Gtk::Entry m_query;
+    Gtk::Button m_find_button{"Find"};
+    Gtk::Box m_options_row{Gtk::ORIENTATION_HORIZONTAL};
+    Gtk::CheckButton m_regex{"Regex"};
+    Gtk::CheckButton m_ignore_case{"Ignore case"};
+    Gtk::ComboBoxText m_encoding;
+    Gtk::Label m_summary;
+
+    Gtk::Box m_list_box{Gtk::ORIENTATION_HORIZONTAL};
+    Gtk::DrawingArea m_list;
+    Glib::RefPtr<Gtk::Adjustment> m_vadj;
+    Gtk::Scrollbar m_vscroll;
+
+    const HexBuffer* m_buffer{nullptr};
+    AnalysisCache* m_cache{nullptr};
+    TextSearch m_search;
+    std::string m_error;
+    bool m_from_cache{false};
+    std::vector<std::size_t> m_hits;
+    std::size_t m_selected{static_cast<std::size_t>(-1)};
+    int m_row_height{16};
+
+    // Worker -> UI hand-off
+    std::future<void> m_job;
+    std::atomic<bool> m_cancel{false};
+    std::mutex m_pending_mutex;
+    std::vector<std::size_t> m_pending;
+    bool m_search_done{false};
+    bool m_searching{false};
+    Glib::Dispatcher m_dispatcher;
+
+    sigc::signal<void, std::size_t, std::size_t> m_signal_match_activated;
+    sigc::signal<void> m_signal_results_ready;
+
+    void on_dispatch();
+    void update_range();
+    void update_summary();
+
+    bool on_list_draw(const Cairo::RefPtr<Cairo::Context>& cr);
+    bool on_list_scroll(GdkEventScroll* ev);
+    bool on_list_button_press(GdkEventButton* ev);
+    void on_list_size_allocate(Gtk::Allocation& alloc);
+};
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef STRINGSCANNER_HPP
+#define STRINGSCANNER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+struct StringHit {
+    std::size_t offset;
+    std::uint32_t length; // in bytes (UTF-16 strings count 2 bytes per char)
+    bool utf16;
+};
+
+struct StringScanOptions {
+    std::size_t min_length = 4;          // in characters
+    bool ascii = true;
+    bool utf16le = true;
+    std::size_t chunk_size = 4u << 20;
+};
+
+class StringScanner {
+public:
+    using BatchCallback = std::function<void(std::vector<StringHit>&&)>;
+
+    // Scans [0,n) in parallel chunks on the shared WorkerPool. Batches are delivered
+    // in ascending offset order, one per chunk, from whichever worker completes the
+    // next chunk.
+    static void scan(const unsigned char* data, std::size_t n,
+                     const StringScanOptions& opts,
+                     const BatchCallback& on_batch,
+                     const std::atomic<bool>* cancel = nullptr);
+
+    // Appends every string whose first byte lies in [begin,end), sorted by offset.
+    // Runs are followed past `end` so a chunk owns the whole string it starts.
+    static void scan_range(const unsigned char* data, std::size_t n,
+                           std::size_t begin, std::size_t end,
+                           const StringScanOptions& opts,
+                           std::vector<StringHit>& out);
+
+    static bool is_printable(unsigned char c);
+};
+
+#endif
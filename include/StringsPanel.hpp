@@ -0,0 +1,74 @@
+#ifndef STRINGSPANEL_HPP
+#define STRINGSPANEL_HPP
+
+#include <gtkmm.h>
+#include "AnalysisCache.hpp"
+#include "HexBuffer.hpp"
+#include "StringScanner.hpp"
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <mutex>
+#include <vector>
+
+// Lists printable ASCII / UTF-16LE strings found in a HexBuffer. The scan runs on
+// the shared WorkerPool and streams its results in; the list draws only visible rows
+// so millions of hits cost no more than a screenful.
+class StringsPanel : public Gtk::Box {
+public:
+    StringsPanel();
+    ~StringsPanel() override;
+
+    void set_buffer(const HexBuffer* buffer);
+    void set_cache(AnalysisCache* cache) { m_cache = cache; }
+    void start_scan();
+
+    // Stops a running scan and drops its results. Call before mutating the buffer.
+    void invalidate();
+
+    sigc::signal<void, std::size_t>& signal_offset_activated() { return m_signal_offset_activated; }
+
+private:
+    Gtk::Box m_controls{Gtk::ORIENTATION_HORIZONTAL};
+    Gtk::Label m_min_label{"Min:"};
+    Gtk::SpinButton m_min_len;
+    Gtk::CheckButton m_ascii{"ASCII"};
+    Gtk::CheckButton m_utf16{"UTF-16LE"};
+    Gtk::Button m_scan_button{"Scan"};
+    Gtk::Label m_summary;
+
+    Gtk::Box m_list_box{Gtk::ORIENTATION_HORIZONTAL};
+    Gtk::DrawingArea m_list;
+    Glib::RefPtr<Gtk::Adjustment> m_vadj;
+    Gtk::Scrollbar m_vscroll;
+
+    const HexBuffer* m_buffer{nullptr};
+    AnalysisCache* m_cache{nullptr};
+    StringScanOptions m_scan_opts;
+    bool m_from_cache{false};
+    std::vector<StringHit> m_hits;
+    std::size_t m_selected{static_cast<std::size_t>(-1)};
+    int m_row_height{16};
+
+    // Worker -> UI hand-off
+    std::future<void> m_job;
+    std::atomic<bool> m_cancel{false};
+    std::mutex m_pending_mutex;
+    std::vector<StringHit> m_pending;
+    bool m_scan_done{false};
+    bool m_scanning{false};
+    Glib::Dispatcher m_dispatcher;
+
+    sigc::signal<void, std::size_t> m_signal_offset_activated;
+
+    void on_dispatch();
+    void update_range();
+    void update_summary();
+
+    bool on_list_draw(const Cairo::RefPtr<Cairo::Context>& cr);
+    bool on_list_scroll(GdkEventScroll* ev);
+    bool on_list_button_press(GdkEventButton* ev);
+    void on_list_size_allocate(Gtk::Allocation& alloc);
+};
+
+#endif
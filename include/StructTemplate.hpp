@@ -0,0 +1,91 @@
+#ifndef STRUCTTEMPLATE_HPP
+#define STRUCTTEMPLATE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// A small structure-definition language compiled to a flat decoding program:
+//
+//   endian little;                  // file default (little or big)
+//   struct Entry { u32 id; char name[16]; }
+//   struct Header {
+//       char magic[4];
+//       be u16 version;             // per-field endianness
+//       u32 count;
+//       u32 table_off;
+//       Entry entries[count] @ table_off;   // count from a field, placed at base + field
+//   }
+//
+// Types: u8 u16 u32 u64 i8 i16 i32 i64 f32 f64 char, or any struct defined earlier.
+// The last struct in the source is the root. Nested structs are inlined at compile
+// time, so decode() is a single loop over fixed-size state and never allocates.
+class StructTemplate {
+public:
+    enum class Type : std::uint8_t { U8, U16, U32, U64, I8, I16, I32, I64, F32, F64, Char, Struct };
+
+    struct Field {
+        std::size_t offset;
+        std::size_t size;
+        const char* name;
+        std::uint32_t count;    // elements for primitive arrays, 1 for scalars
+        std::int32_t index;     // element index for struct array members, -1 otherwise
+        Type type;
+        std::uint8_t depth;
+        std::uint8_t color;
+        bool big_endian;
+    };
+
+    static constexpr std::size_t kColors = 8;
+
+    bool compile(const std::string& source, std::string& error);
+    bool empty() const { return m_ops.empty(); }
+    const std::string& root_name() const { return m_root_name; }
+
+    // Decodes the template anchored at `base` into `out` (at most `cap` entries) and
+    // returns the number written. Only fields overlapping [win_begin, win_end) are
+    // emitted; with `leaves_only` struct headers are skipped too (for overlays).
+    std::size_t decode(const unsigned char* data, std::size_t n, std::size_t base,
+                       std::size_t win_begin, std::size_t win_end,
+                       Field* out, std::size_t cap, bool leaves_only = false) const;
+
+    static std::size_t type_size(Type t);
+    static const char* type_name(Type t);
+    // Formats a scalar field (or the first element of an array) into `buf`.
+    static void format_value(const Field& f, const unsigned char* data, std::size_t n,
+                             char* buf, std::size_t buf_len);
+
+private:
+    enum class OpCode : std::uint8_t { Field, StructBegin, StructEnd, LoopBegin, LoopEnd, AtBegin, AtEnd };
+
+    struct Op {
+        OpCode code;
+        Type type{Type::U8};
+        bool big_endian{false};
+        bool element{false};            // StructBegin: member of a struct array
+        std::uint8_t depth{0};
+        std::uint8_t color{0};
+        std::int16_t reg{-1};           // Field: store the decoded value here
+        std::int16_t count_reg{-1};     // Field / LoopBegin: element count from a register
+        std::int16_t at_reg{-1};        // AtBegin: seek to base + register
+        std::uint32_t name{0};
+        std::uint32_t jump{0};          // LoopBegin <-> LoopEnd
+        std::uint64_t count{1};
+        std::uint64_t fixed_size{0};    // LoopBegin: bytes per iteration when constant
+    };
+
+    static constexpr std::size_t kMaxRegs = 256;
+    static constexpr std::size_t kMaxDepth = 32;
+    static constexpr std::size_t kMaxSteps = 1u << 20;
+
+    std::vector<Op> m_ops;
+    std::vector<std::string> m_names;
+    std::string m_root_name;
+    bool m_has_seeks{false};
+
+    friend class TemplateCompiler;
+};
+
+#endif
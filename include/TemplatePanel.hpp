@@ -0,0 +1,70 @@
+#ifndef TEMPLATEPANEL_HPP
+#define TEMPLATEPANEL_HPP
+
+#include <gtkmm.h>
+#include "HexBuffer.hpp"
+#include "StructTemplate.hpp"
+#include <cstddef>
+#include <vector>
+
+// Loads a structure template, anchors it at a byte offset and shows the decoded
+// fields as a tree. The hex view draws the matching colored overlay itself.
+class TemplatePanel : public Gtk::Box {
+public:
+    TemplatePanel();
+
+    void set_buffer(const HexBuffer* buffer);
+
+    // Decodes the loaded template at `base` and rebuilds the tree.
+    void apply_at(std::size_t base);
+    // Re-decodes at the current base (after the buffer changed).
+    void refresh();
+    void clear();
+
+    const StructTemplate* active_template() const { return m_applied ? &m_template : nullptr; }
+    std::size_t base() const { return m_base; }
+
+    sigc::signal<void>& signal_apply_requested() { return m_signal_apply_requested; }
+    sigc::signal<void>& signal_template_changed() { return m_signal_template_changed; }
+    sigc::signal<void, std::size_t>& signal_offset_activated() { return m_signal_offset_activated; }
+
+private:
+    static constexpr std::size_t kTreeCapacity = 20000;
+
+    struct Columns : public Gtk::TreeModel::ColumnRecord {
+        Columns() { add(name); add(type); add(offset_text); add(value); add(offset); }
+        Gtk::TreeModelColumn<Glib::ustring> name;
+        Gtk::TreeModelColumn<Glib::ustring> type;
+        Gtk::TreeModelColumn<Glib::ustring> offset_text;
+        Gtk::TreeModelColumn<Glib::ustring> value;
+        Gtk::TreeModelColumn<guint64> offset;
+    };
+
+    Gtk::Box m_controls{Gtk::ORIENTATION_HORIZONTAL};
+    Gtk::Button m_load_button{"Load..."};
+    Gtk::Button m_apply_button{"Apply at Cursor"};
+    Gtk::Button m_clear_button{"Clear"};
+    Gtk::Label m_summary;
+
+    Gtk::ScrolledWindow m_scroll;
+    Gtk::TreeView m_tree;
+    Columns m_columns;
+    Glib::RefPtr<Gtk::TreeStore> m_store;
+
+    const HexBuffer* m_buffer{nullptr};
+    StructTemplate m_template;
+    std::string m_template_name;
+    std::size_t m_base{0};
+    bool m_applied{false};
+    std::vector<StructTemplate::Field> m_fields;
+
+    sigc::signal<void> m_signal_apply_requested;
+    sigc::signal<void> m_signal_template_changed;
+    sigc::signal<void, std::size_t> m_signal_offset_activated;
+
+    void on_load_clicked();
+    void on_row_activated(const Gtk::TreeModel::Path& path, Gtk::TreeViewColumn* column);
+    void rebuild_tree();
+};
+
+#endif
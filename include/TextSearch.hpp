@@ -0,0 +1,87 @@
+#ifndef TEXTSEARCH_HPP
+#define TEXTSEARCH_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+enum class TextEncoding { Ascii, Utf16LE, Utf16BE };
+
+struct TextSearchOptions {
+    bool regex = false;
+    bool ignore_case = false;            // ASCII letters only
+    TextEncoding encoding = TextEncoding::Ascii;
+    std::size_t max_match = 256;         // longest match reported, in bytes; raised
+                                         // to the pattern's shortest match if below it
+    std::size_t chunk_size = 4u << 20;
+};
+
+// Text search over binary data: a literal, or a byte-level regular expression with
+// literals, ., [classes], \d \w \s \xHH, (groups), | and * + ? {m,n}. UTF-16 modes
+// decode the UTF-8 pattern and match each character as its code unit, or as a
+// surrogate pair above U+FFFF; ., classes and escapes stay in U+0000..U+00FF. The
+// pattern is compiled to a DFA over byte classes; matches are leftmost-longest, do
+// not overlap and are capped at max_match bytes, so a chunk never reads further
+// than that past its end.
+class TextSearch {
+public:
+    using BatchCallback = std::function<void(std::vector<std::size_t>&&)>;
+
+    static constexpr std::size_t kMaxStates = 4096;
+
+    bool compile(const std::string& pattern, const TextSearchOptions& opts, std::string& error);
+    bool valid() const { return !m_accept.empty(); }
+    const std::string& pattern() const { return m_pattern; }
+    const TextSearchOptions& options() const { return m_opts; }
+
+    // Pattern plus options as bytes; AnalysisCache stores hit lists under this key.
+    std::vector<unsigned char> key() const;
+    bool compile_key(const std::vector<unsigned char>& key);
+
+    // Length of the longest match starting exactly at `offset`, 0 if none.
+    std::size_t match_at(const unsigned char* data, std::size_t n, std::size_t offset) const;
+
+    // First match starting in [pos, limit). Candidates are found with memchr on the
+    // pattern's literal prefix when it has one, else by its possible first bytes.
+    bool next(const unsigned char* data, std::size_t n, std::size_t pos, std::size_t limit,
+              std::size_t& offset, std::size_t& length) const;
+
+    // Start offsets of all matches in [0,n), scanned in parallel chunks on the shared
+    // WorkerPool. Batches arrive in ascending order, one per chunk; where a match runs
+    // across a chunk boundary the next chunk is re-scanned until it falls back in step.
+    void find(const unsigned char* data, std::size_t n, const BatchCallback& on_batch,
+              const std::atomic<bool>* cancel = nullptr) const;
+
+    // Brings `hits` from an earlier find() up to date after the sorted byte ranges
+    // in `changed` were rewritten, scanning only around the changes.
+    void repair(const unsigned char* data, std::size_t n,
+                const std::vector<std::pair<std::size_t, std::size_t>>& changed,
+                std::vector<std::size_t>& hits) const;
+
+private:
+    std::string m_pattern;
+    TextSearchOptions m_opts;
+
+    std::array<std::uint8_t, 256> m_class{};
+    std::size_t m_class_count{0};
+    std::vector<std::uint32_t> m_next;     // state * m_class_count + class; state 0 is dead
+    std::vector<char> m_accept;
+    std::vector<unsigned char> m_prefix;   // bytes every match starts with
+    std::size_t m_anchor{0};               // prefix byte memchr looks for
+    std::array<bool, 256> m_first{};       // bytes a match can start with
+
+    // Appends matches from `pos` until one at or after `sync_from` is also in
+    // expected[k..]; returns its index there, or expected.size() if none turns up
+    // before `limit`. `pos` is left at the end of the last appended match.
+    std::size_t resync(const unsigned char* data, std::size_t n, std::size_t& pos,
+                       std::size_t limit, std::size_t sync_from,
+                       const std::vector<std::size_t>& expected, std::size_t k,
+                       std::vector<std::size_t>& out) const;
+};
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef VALUEDECODER_HPP
+#define VALUEDECODER_HPP
+
+#include <array>
+#include <cstddef>
+
+// Decodes the bytes at an offset as every common scalar type, in both byte orders,
+// into fixed-size text buffers. Nothing here touches the heap, so it is safe to run
+// on every cursor move.
+class ValueDecoder {
+public:
+    enum Row {
+        Int8, UInt8, Int16, UInt16, Int32, UInt32, Int64, UInt64,
+        Half, Float, Double, ULeb128, SLeb128, Time32, Time64,
+        Guid, Utf8, Utf16, Binary,
+        kRowCount
+    };
+
+    static constexpr std::size_t kTextLen = 48;
+
+    struct Values {
+        std::array<std::array<char, kTextLen>, kRowCount> little;
+        std::array<std::array<char, kTextLen>, kRowCount> big;
+    };
+
+    static const char* row_label(Row row);
+    static void decode(const unsigned char* data, std::size_t n, std::size_t offset, Values& out);
+};
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef WORKERPOOL_HPP
+#define WORKERPOOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Process-wide thread pool shared by every open document. Background jobs (string
+// scans, cache indexing, searches) are queued here instead of each spawning its own
+// threads, so opening more tabs never multiplies the number of running threads.
+class WorkerPool {
+public:
+    // One thread per hardware thread, created on first use.
+    static WorkerPool& shared();
+
+    explicit WorkerPool(unsigned threads = 0);
+    ~WorkerPool();
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    unsigned size() const { return static_cast<unsigned>(m_threads.size()); }
+
+    // Queues a job; the future becomes ready when it has run.
+    std::future<void> submit(std::function<void()> job);
+
+    // Runs fn(i) for every i in [0,count) and returns when all calls are done. The
+    // calling thread takes indices too, so this is safe to call from inside a job
+    // even when every worker is busy.
+    void parallel_for(std::size_t count, const std::function<void(std::size_t)>& fn);
+
+private:
+    std::vector<std::thread> m_threads;
+    std::deque<std::function<void()>> m_queue;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_stopping{false};
+
+    void run();
+};
+
+#endif
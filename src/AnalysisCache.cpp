@@ -0,0 +1,630 @@
+#include "AnalysisCache.hpp"
+#include "WorkerPool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+struct AnalysisCache::Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t block_size;
+    std::uint64_t file_size;     // on disk; compressed inputs differ from data_size
+    std::int64_t mtime_ns;
+    std::uint64_t data_size;     // bytes the results describe
+    std::uint64_t block_count;
+    std::uint64_t string_count;
+    std::uint32_t string_min_len;
+    std::uint32_t string_flags;
+    std::uint64_t search_count;
+    std::uint64_t off_checksums;
+    std::uint64_t off_entropy;
+    std::uint64_t off_strings;
+    std::uint64_t off_searches;
+    std::uint64_t off_classes;
+};
+
+namespace {
+
+constexpr char kMagic[8] = {'H', 'X', 'I', 'D', 'X', 0, 0, 0};
+constexpr std::uint32_t kVersion = 3;
+
+constexpr std::uint32_t kStringsPresent = 1u << 31;
+constexpr std::uint32_t kStringsAscii   = 1u << 0;
+constexpr std::uint32_t kStringsUtf16   = 1u << 1;
+
+struct DiskString {
+    std::uint64_t offset;
+    std::uint32_t length;
+    std::uint32_t utf16;
+};
+
+// DiskSearch::kind
+constexpr std::uint32_t kLiteralSearch = 0;
+constexpr std::uint32_t kTextSearch    = 1;
+
+struct DiskSearch {
+    std::uint32_t pattern_len;
+    std::uint32_t kind;
+    std::uint64_t hit_count;
+    // followed by pattern bytes padded to 8, then hit_count uint64 offsets
+};
+
+std::size_t align8(std::size_t v) { return (v + 7) & ~static_cast<std::size_t>(7); }
+
+bool same_options(const StringScanOptions& a, const StringScanOptions& b) {
+    return a.min_length == b.min_length && a.ascii == b.ascii && a.utf16le == b.utf16le;
+}
+
+// Entropy and class mix share one histogram of the block.
+void block_stats(const unsigned char* p, std::size_t len, float& entropy, ByteClassMix& mix) {
+    entropy = 0.0f;
+    mix = {};
+    if (len == 0) return;
+    std::uint32_t counts[256] = {};
+    for (std::size_t i = 0; i < len; ++i) ++counts[p[i]];
+
+    double h = 0.0;
+    const double inv = 1.0 / static_cast<double>(len);
+    std::size_t text = counts['\t'] + counts['\n'] + counts['\r'], high = 0;
+    for (std::size_t b = 0; b < 256; ++b) {
+        const std::uint32_t c = counts[b];
+        if (!c) continue;
+        double q = c * inv;
+        h -= q * std::log2(q);
+        if (b >= 0x80) high += c;
+        else if (b >= 0x20 && b < 0x7F) text += c;
+    }
+    entropy = static_cast<float>(h);
+
+    auto share = [len](std::size_t c) { return static_cast<std::uint8_t>((c * 255 + len / 2) / len); };
+    mix.zero = share(counts[0]);
+    mix.text = share(text);
+    mix.high = share(high);
+    mix.control = share(len - counts[0] - text - high);
+}
+
+void find_all(const unsigned char* data, std::size_t n, std::size_t first, std::size_t last,
+              const std::vector<unsigned char>& pat, std::vector<std::size_t>& out) {
+    const std::size_t m = pat.size();
+    if (m == 0 || n < m) return;
+    last = std::min(last, n - m + 1);
+    std::size_t i = first;
+    while (i < last) {
+        const void* hit = std::memchr(data + i, pat[0], last - i);
+        if (!hit) break;
+        i = static_cast<std::size_t>(static_cast<const unsigned char*>(hit) - data);
+        if (std::memcmp(data + i, pat.data(), m) == 0) out.push_back(i);
+        ++i;
+    }
+}
+
+} // namespace
+
+AnalysisCache::~AnalysisCache() {
+    unmap();
+}
+
+std::uint64_t AnalysisCache::hash_block(const unsigned char* p, std::size_t len) {
+    constexpr std::uint64_t kMul = 0x9E3779B97F4A7C15ull;
+    std::uint64_t h = 0xCBF29CE484222325ull ^ (len * kMul);
+    std::size_t i = 0;
+    for (; i + 8 <= len; i += 8) {
+        std::uint64_t w;
+        std::memcpy(&w, p + i, 8);
+        w *= kMul;
+        w ^= w >> 32;
+        h = (h ^ w) * 0x100000001B3ull;
+    }
+    for (; i < len; ++i) h = (h ^ p[i]) * 0x100000001B3ull;
+    h ^= h >> 29;
+    return h;
+}
+
+std::string AnalysisCache::sidecar_path(const std::string& canonical_path) {
+    std::string dir;
+    if (const char* xdg = std::getenv("XDG_CACHE_HOME"); xdg && *xdg) dir = xdg;
+    else if (const char* home = std::getenv("HOME"); home && *home) dir = std::string(home) + "/.cache";
+    else return {};
+    dir += "/hexeditpro";
+
+    const auto key = hash_block(reinterpret_cast<const unsigned char*>(canonical_path.data()),
+                                canonical_path.size());
+    char name[32];
+    std::snprintf(name, sizeof(name), "/%016llx.idx", static_cast<unsigned long long>(key));
+    return dir + name;
+}
+
+bool AnalysisCache::stat_file(const std::string& path) {
+    struct stat st{};
+    if (::stat(path.c_str(), &st) != 0) return false;
+    m_file_size = static_cast<std::uint64_t>(st.st_size);
+    m_mtime_ns = static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec;
+    return true;
+}
+
+void AnalysisCache::attach(const std::string& path, const unsigned char* data, std::size_t n) {
+    detach();
+
+    std::error_code ec;
+    auto canon = std::filesystem::weakly_canonical(path, ec);
+    m_path = ec ? path : canon.string();
+    m_sidecar = sidecar_path(m_path);
+    if (!stat_file(m_path) || m_sidecar.empty()) {
+        m_path.clear();
+        return;
+    }
+    m_data_size = n;
+
+    if (map_sidecar()) {
+        const auto* sums = reinterpret_cast<const std::uint64_t*>(m_map + m_header->off_checksums);
+        const auto* ent  = reinterpret_cast<const float*>(m_map + m_header->off_entropy);
+        const auto* cls  = reinterpret_cast<const ByteClassMix*>(m_map + m_header->off_classes);
+        m_checksums.assign(sums, sums + m_header->block_count);
+        m_entropy.assign(ent, ent + m_header->block_count);
+        m_classes.assign(cls, cls + m_header->block_count);
+
+        m_fresh = m_header->file_size == m_file_size && m_header->mtime_ns == m_mtime_ns &&
+                  m_header->data_size == n;
+    }
+
+    m_matches_disk = true;
+    if (m_fresh) {
+        m_reconciled = true;
+        return;
+    }
+    reconcile(data, n);
+    persist();
+}
+
+void AnalysisCache::detach() {
+    unmap();
+    m_path.clear();
+    m_sidecar.clear();
+    m_file_size = 0;
+    m_data_size = 0;
+    m_mtime_ns = 0;
+    m_checksums.clear();
+    m_entropy.clear();
+    m_classes.clear();
+    m_dirty_count = 0;
+    m_fresh = false;
+    m_reconciled = false;
+    m_matches_disk = false;
+    m_have_strings = false;
+    m_strings.clear();
+    m_searches.clear();
+    m_text_searches.clear();
+}
+
+void AnalysisCache::mark_modified() {
+    m_reconciled = false;
+    m_matches_disk = false;
+    m_fresh = false;
+}
+
+void AnalysisCache::file_saved(const std::string& path, const unsigned char* data, std::size_t n) {
+    std::error_code ec;
+    auto canon = std::filesystem::weakly_canonical(path, ec);
+    const std::string resolved = ec ? path : canon.string();
+
+    if (resolved != m_path) {
+        // Results describe the contents, not the name: carry them over to the new path.
+        m_path = resolved;
+        m_sidecar = sidecar_path(m_path);
+    }
+    if (m_sidecar.empty() || !stat_file(m_path)) {
+        m_path.clear();
+        return;
+    }
+    if (!m_reconciled) reconcile(data, n);
+    m_matches_disk = true;
+    persist();
+}
+
+void AnalysisCache::file_reloaded(std::int64_t mtime_ns, bool contents_changed) {
+    if (!attached()) return;
+    if (!stat_file(m_path)) {
+        m_path.clear();
+        return;
+    }
+    if (contents_changed) {
+        m_reconciled = false;
+        m_fresh = false;
+    }
+    // The file may have moved on again since the buffer read it; the next sync catches up.
+    m_matches_disk = m_mtime_ns == mtime_ns;
+}
+
+bool AnalysisCache::map_sidecar() {
+    int fd = ::open(m_sidecar.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(Header)) {
+        ::close(fd);
+        return false;
+    }
+
+    const std::size_t size = static_cast<std::size_t>(st.st_size);
+    void* p = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) return false;
+
+    m_map = static_cast<const unsigned char*>(p);
+    m_map_size = size;
+    m_header = reinterpret_cast<const Header*>(m_map);
+
+    auto fits = [size](std::uint64_t off, std::uint64_t bytes) {
+        return off % 8 == 0 && off <= size && bytes <= size - off;
+    };
+
+    const Header& h = *m_header;
+    bool ok = std::memcmp(h.magic, kMagic, sizeof(kMagic)) == 0 &&
+              h.version == kVersion && h.block_size == kBlockSize &&
+              h.block_count == (h.data_size + kBlockSize - 1) / kBlockSize &&
+              h.block_count < size &&
+              fits(h.off_checksums, h.block_count * sizeof(std::uint64_t)) &&
+              fits(h.off_entropy, h.block_count * sizeof(float)) &&
+              fits(h.off_classes, h.block_count * sizeof(ByteClassMix)) &&
+              h.string_count < size &&
+              fits(h.off_strings, h.string_count * sizeof(DiskString)) &&
+              fits(h.off_searches, 0);
+
+    // Walk the search directory once so later reads need no bounds checks.
+    std::uint64_t off = h.off_searches;
+    for (std::uint64_t i = 0; ok && i < h.search_count; ++i) {
+        if (!fits(off, sizeof(DiskSearch))) { ok = false; break; }
+        const auto* ds = reinterpret_cast<const DiskSearch*>(m_map + off);
+        off += sizeof(DiskSearch) + align8(ds->pattern_len);
+        if (ds->hit_count >= size || !fits(off, ds->hit_count * sizeof(std::uint64_t))) { ok = false; break; }
+        off += ds->hit_count * sizeof(std::uint64_t);
+    }
+
+    if (!ok) unmap();
+    return ok;
+}
+
+void AnalysisCache::unmap() {
+    if (m_map) ::munmap(const_cast<unsigned char*>(m_map), m_map_size);
+    m_map = nullptr;
+    m_map_size = 0;
+    m_header = nullptr;
+}
+
+bool AnalysisCache::mapped_strings(StringScanOptions& opts, std::vector<StringHit>& out) const {
+    if (!m_header || !(m_header->string_flags & kStringsPresent)) return false;
+    opts.min_length = m_header->string_min_len;
+    opts.ascii = (m_header->string_flags & kStringsAscii) != 0;
+    opts.utf16le = (m_header->string_flags & kStringsUtf16) != 0;
+
+    const auto* ds = reinterpret_cast<const DiskString*>(m_map + m_header->off_strings);
+    out.resize(m_header->string_count);
+    for (std::size_t i = 0; i < out.size(); ++i)
+        out[i] = {static_cast<std::size_t>(ds[i].offset), ds[i].length, ds[i].utf16 != 0};
+    return true;
+}
+
+void AnalysisCache::mapped_searches(std::uint32_t kind, HitLists& out) const {
+    if (!m_header) return;
+    std::uint64_t off = m_header->off_searches;
+    for (std::uint64_t i = 0; i < m_header->search_count; ++i) {
+        const auto* ds = reinterpret_cast<const DiskSearch*>(m_map + off);
+        const unsigned char* pat = m_map + off + sizeof(DiskSearch);
+        off += sizeof(DiskSearch) + align8(ds->pattern_len);
+        const auto* hits = reinterpret_cast<const std::uint64_t*>(m_map + off);
+        off += ds->hit_count * sizeof(std::uint64_t);
+
+        if (ds->kind != kind) continue;
+        std::vector<unsigned char> key(pat, pat + ds->pattern_len);
+        if (out.count(key)) continue;
+        out.emplace(std::move(key), std::vector<std::size_t>(hits, hits + ds->hit_count));
+    }
+}
+
+void AnalysisCache::reconcile(const unsigned char* data, std::size_t n) {
+    // Everything still in the mapping becomes owned so it can be repaired.
+    if (m_map) {
+        if (!m_have_strings) m_have_strings = mapped_strings(m_string_opts, m_strings);
+        mapped_searches(kLiteralSearch, m_searches);
+        mapped_searches(kTextSearch, m_text_searches);
+        unmap();
+    }
+
+    m_data_size = n;
+    const std::size_t B = kBlockSize;
+    const std::size_t nblocks = (n + B - 1) / B;
+
+    std::vector<std::uint64_t> sums(nblocks);
+    WorkerPool::shared().parallel_for(nblocks, [&](std::size_t b) {
+        sums[b] = hash_block(data + b * B, std::min(B, n - b * B));
+    });
+
+    std::vector<char> dirty(nblocks, 0);
+    m_dirty_count = 0;
+    for (std::size_t b = 0; b < nblocks; ++b) {
+        dirty[b] = b >= m_checksums.size() || m_checksums[b] != sums[b];
+        m_dirty_count += dirty[b] ? 1 : 0;
+    }
+
+    m_entropy.resize(nblocks);
+    m_classes.resize(nblocks);
+    WorkerPool::shared().parallel_for(nblocks, [&](std::size_t b) {
+        if (dirty[b]) block_stats(data + b * B, std::min(B, n - b * B), m_entropy[b], m_classes[b]);
+    });
+
+    const bool shrunk = m_checksums.size() > nblocks;
+    m_checksums = std::move(sums);
+    m_reconciled = true;
+    if (m_dirty_count == 0 && !shrunk) return;
+
+    auto block_dirty = [&](std::size_t b) { return b >= nblocks || dirty[b]; };
+    // A result stays valid only if no byte it depends on lies in a changed block.
+    auto range_dirty = [&](std::size_t begin, std::size_t end) {
+        for (std::size_t b = begin / B; b <= (end - 1) / B; ++b)
+            if (block_dirty(b)) return true;
+        return false;
+    };
+
+    if (m_have_strings) {
+        std::vector<StringHit> repaired;
+        repaired.reserve(m_strings.size());
+        std::size_t k = 0;
+        for (std::size_t b = 0; b < nblocks; ++b) {
+            const std::size_t lo = b * B, hi = lo + B;
+            std::size_t k_end = k;
+            while (k_end < m_strings.size() && m_strings[k_end].offset < hi) ++k_end;
+
+            // Strings run past their block and UTF-16 looks two bytes back, so a
+            // change next door can alter what this block owns: a short run at the
+            // end of b becomes a string when b+1 extends it.
+            bool rescan = block_dirty(b) || (b > 0 && block_dirty(b - 1)) || block_dirty(b + 1);
+            for (std::size_t j = k; !rescan && j < k_end; ++j)
+                rescan = range_dirty(m_strings[j].offset, m_strings[j].offset + m_strings[j].length + 2);
+
+            if (rescan) StringScanner::scan_range(data, n, lo, hi, m_string_opts, repaired);
+            else repaired.insert(repaired.end(), m_strings.begin() + static_cast<long>(k),
+                                 m_strings.begin() + static_cast<long>(k_end));
+            k = k_end;
+        }
+        m_strings = std::move(repaired);
+    }
+
+    for (auto& [pattern, hits] : m_searches) {
+        const std::size_t m = pattern.size();
+        std::vector<std::size_t> repaired;
+        repaired.reserve(hits.size());
+        std::size_t k = 0;
+        std::size_t prev_hi = 0;
+
+        for (std::size_t b = 0; b <= nblocks; ++b) {
+            // Maximal run of dirty blocks [b, e); hits starting up to m-1 bytes
+            // before it can overlap the change.
+            if (b < nblocks && !dirty[b]) continue;
+            std::size_t e = b;
+            while (e < nblocks && dirty[e]) ++e;
+
+            const std::size_t lo = std::max(prev_hi, (b * B >= m - 1) ? b * B - (m - 1) : 0);
+            const std::size_t hi = std::min(n, e * B);
+            while (k < hits.size() && hits[k] < lo) {
+                if (hits[k] + m <= n) repaired.push_back(hits[k]);
+                ++k;
+            }
+            if (b == nblocks) break;
+            find_all(data, n, lo, hi, pattern, repaired);
+            while (k < hits.size() && hits[k] < hi) ++k;
+            prev_hi = hi;
+            b = e;
+        }
+        hits = std::move(repaired);
+    }
+
+    if (m_text_searches.empty()) return;
+    std::vector<std::pair<std::size_t, std::size_t>> changed;
+    for (std::size_t b = 0; b < nblocks; ++b) {
+        if (!dirty[b]) continue;
+        std::size_t e = b;
+        while (e < nblocks && dirty[e]) ++e;
+        changed.emplace_back(b * B, std::min(n, e * B));
+        b = e;
+    }
+    // Hits that ran into the cut-off tail are checked again.
+    if (shrunk && nblocks > 0 && (changed.empty() || changed.back().second < n))
+        changed.emplace_back((nblocks - 1) * B, n);
+
+    for (auto it = m_text_searches.begin(); it != m_text_searches.end();) {
+        TextSearch search;
+        if (!search.compile_key(it->first)) {
+            it = m_text_searches.erase(it);
+            continue;
+        }
+        search.repair(data, n, changed, it->second);
+        ++it;
+    }
+}
+
+const std::vector<float>& AnalysisCache::block_entropy(const unsigned char* data, std::size_t n) {
+    if (!m_reconciled) reconcile(data, n);
+    return m_entropy;
+}
+
+void AnalysisCache::update_classes(const unsigned char* data, std::size_t n, std::size_t begin, std::size_t end) {
+    const std::size_t B = kBlockSize;
+    m_classes.resize((n + B - 1) / B);
+    end = std::min(end, n);
+    if (begin >= end) return;
+
+    const std::size_t first = begin / B;
+    WorkerPool::shared().parallel_for((end - 1) / B + 1 - first, [&](std::size_t i) {
+        const std::size_t b = first + i;
+        float entropy = 0.0f;   // left to reconcile(), which also refreshes the checksums
+        block_stats(data + b * B, std::min(B, n - b * B), entropy, m_classes[b]);
+    });
+}
+
+bool AnalysisCache::strings(const unsigned char* data, std::size_t n,
+                            const StringScanOptions& opts, std::vector<StringHit>& out) {
+    if (!attached()) return false;
+    if (!m_reconciled) reconcile(data, n);
+
+    if (m_have_strings) {
+        if (!same_options(m_string_opts, opts)) return false;
+        out = m_strings;
+        return true;
+    }
+    StringScanOptions mapped_opts;
+    std::vector<StringHit> hits;
+    if (!mapped_strings(mapped_opts, hits) || !same_options(mapped_opts, opts)) return false;
+    out = std::move(hits);
+    return true;
+}
+
+void AnalysisCache::store_strings(const StringScanOptions& opts, const std::vector<StringHit>& hits) {
+    if (!attached()) return;
+    m_string_opts = opts;
+    m_strings = hits;
+    m_have_strings = true;
+    persist();
+}
+
+bool AnalysisCache::search_hits(const unsigned char* data, std::size_t n,
+                                const std::vector<unsigned char>& pattern, std::vector<std::size_t>& out) {
+    if (!attached() || pattern.empty()) return false;
+    if (!m_reconciled) reconcile(data, n);
+
+    auto it = m_searches.find(pattern);
+    if (it == m_searches.end() && m_map) {
+        mapped_searches(kLiteralSearch, m_searches);
+        it = m_searches.find(pattern);
+    }
+    if (it == m_searches.end()) return false;
+    out = it->second;
+    return true;
+}
+
+void AnalysisCache::store_search_hits(const std::vector<unsigned char>& pattern,
+                                      const std::vector<std::size_t>& hits) {
+    if (!attached() || pattern.empty()) return;
+    if (m_map) mapped_searches(kLiteralSearch, m_searches);
+    m_searches[pattern] = hits;
+    persist();
+}
+
+bool AnalysisCache::text_search_hits(const unsigned char* data, std::size_t n,
+                                     const TextSearch& search, std::vector<std::size_t>& out) {
+    if (!attached() || !search.valid()) return false;
+    if (!m_reconciled) reconcile(data, n);
+
+    const auto key = search.key();
+    auto it = m_text_searches.find(key);
+    if (it == m_text_searches.end() && m_map) {
+        mapped_searches(kTextSearch, m_text_searches);
+        it = m_text_searches.find(key);
+    }
+    if (it == m_text_searches.end()) return false;
+    out = it->second;
+    return true;
+}
+
+void AnalysisCache::store_text_search_hits(const TextSearch& search, const std::vector<std::size_t>& hits) {
+    if (!attached() || !search.valid()) return;
+    if (m_map) mapped_searches(kTextSearch, m_text_searches);
+    m_text_searches[search.key()] = hits;
+    persist();
+}
+
+bool AnalysisCache::persist() {
+    if (!attached() || !m_matches_disk || !m_reconciled) return false;
+
+    StringScanOptions sopts = m_string_opts;
+    std::vector<StringHit> strings;
+    bool have_strings = m_have_strings;
+    if (have_strings) strings = m_strings;
+    else have_strings = mapped_strings(sopts, strings);
+
+    auto searches = m_searches;
+    mapped_searches(kLiteralSearch, searches);
+    auto text_searches = m_text_searches;
+    mapped_searches(kTextSearch, text_searches);
+
+    Header h{};
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version = kVersion;
+    h.block_size = kBlockSize;
+    h.file_size = m_file_size;
+    h.data_size = m_data_size;
+    h.mtime_ns = m_mtime_ns;
+    h.block_count = m_checksums.size();
+    h.string_count = have_strings ? strings.size() : 0;
+    h.string_min_len = static_cast<std::uint32_t>(sopts.min_length);
+    h.string_flags = have_strings ? (kStringsPresent | (sopts.ascii ? kStringsAscii : 0) |
+                                     (sopts.utf16le ? kStringsUtf16 : 0)) : 0;
+    h.search_count = searches.size() + text_searches.size();
+    h.off_checksums = align8(sizeof(Header));
+    h.off_entropy = align8(h.off_checksums + h.block_count * sizeof(std::uint64_t));
+    h.off_classes = align8(h.off_entropy + h.block_count * sizeof(float));
+    h.off_strings = align8(h.off_classes + h.block_count * sizeof(ByteClassMix));
+    h.off_searches = align8(h.off_strings + h.string_count * sizeof(DiskString));
+
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(m_sidecar).parent_path(), ec);
+
+    const std::string tmp = m_sidecar + ".tmp";
+    {
+        std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+        if (!file) return false;
+
+        auto put = [&file](const void* p, std::size_t len) {
+            file.write(static_cast<const char*>(p), static_cast<std::streamsize>(len));
+        };
+        auto pad = [&file, &put] {
+            static const char zeros[8] = {};
+            const auto pos = static_cast<std::size_t>(file.tellp());
+            put(zeros, align8(pos) - pos);
+        };
+
+        put(&h, sizeof(h));
+        pad();
+        put(m_checksums.data(), m_checksums.size() * sizeof(std::uint64_t));
+        pad();
+        put(m_entropy.data(), m_entropy.size() * sizeof(float));
+        pad();
+        put(m_classes.data(), m_classes.size() * sizeof(ByteClassMix));
+        pad();
+        for (std::size_t i = 0; i < h.string_count; ++i) {
+            DiskString ds{strings[i].offset, strings[i].length, strings[i].utf16 ? 1u : 0u};
+            put(&ds, sizeof(ds));
+        }
+        pad();
+        auto put_searches = [&](const HitLists& lists, std::uint32_t kind) {
+            for (const auto& [pattern, hits] : lists) {
+                DiskSearch ds{static_cast<std::uint32_t>(pattern.size()), kind, hits.size()};
+                put(&ds, sizeof(ds));
+                put(pattern.data(), pattern.size());
+                pad();
+                for (std::size_t off : hits) {
+                    std::uint64_t v = off;
+                    put(&v, sizeof(v));
+                }
+            }
+        };
+        put_searches(searches, kLiteralSearch);
+        put_searches(text_searches, kTextSearch);
+        if (!file) return false;
+    }
+
+    std::filesystem::rename(tmp, m_sidecar, ec);
+    if (ec) {
+        std::filesystem::remove(tmp, ec);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,507 @@
+#include "CompressedSource.hpp"
+#include "WorkerPool.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#include <lzma.h>
+#include <sys/stat.h>
+#include <zlib.h>
+
+#if __has_include(<zstd.h>)
+#include <zstd.h>
+#define HEXEDITPRO_HAVE_ZSTD 1
+#endif
+
+namespace {
+
+constexpr std::size_t kInputSize = 64u << 10;
+
+// Buffered forward reader that knows the file offset of its next unconsumed byte.
+class Input {
+public:
+    bool open(const std::string& path, std::uint64_t offset) {
+        m_file.open(path, std::ios::binary);
+        if (!m_file) return false;
+        m_file.seekg(static_cast<std::streamoff>(offset));
+        m_base = offset;
+        return static_cast<bool>(m_file);
+    }
+
+    // Refills when everything has been consumed; false at end of file.
+    bool fill() {
+        if (avail() > 0) return true;
+        m_base += m_tail;
+        m_head = m_tail = 0;
+        m_file.read(reinterpret_cast<char*>(m_buf.data()), static_cast<std::streamsize>(m_buf.size()));
+        m_tail = static_cast<std::size_t>(std::max<std::streamsize>(0, m_file.gcount()));
+        return m_tail > 0;
+    }
+
+    bool read_exact(unsigned char* dst, std::size_t n) {
+        while (n > 0) {
+            if (!fill()) return false;
+            const std::size_t k = std::min(n, avail());
+            std::memcpy(dst, data(), k);
+            consume(k);
+            dst += k;
+            n -= k;
+        }
+        return true;
+    }
+
+    const unsigned char* data() const { return m_buf.data() + m_head; }
+    std::size_t avail() const { return m_tail - m_head; }
+    void consume(std::size_t n) { m_head += n; }
+    std::uint64_t pos() const { return m_base + m_head; }
+
+private:
+    std::ifstream m_file;
+    std::vector<unsigned char> m_buf = std::vector<unsigned char>(kInputSize);
+    std::size_t m_head{0};
+    std::size_t m_tail{0};
+    std::uint64_t m_base{0};
+};
+
+bool stat_file(const std::string& path, std::uint64_t& size, std::int64_t& mtime_ns) {
+    struct stat st{};
+    if (::stat(path.c_str(), &st) != 0) return false;
+    size = static_cast<std::uint64_t>(st.st_size);
+    mtime_ns = static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+    return true;
+}
+
+bool cancelled(const std::atomic<bool>* cancel) {
+    return cancel && cancel->load(std::memory_order_relaxed);
+}
+
+} // namespace
+
+CompressedSource::Format CompressedSource::detect(const std::string& path) {
+    unsigned char magic[6] = {};
+    std::ifstream file(path, std::ios::binary);
+    if (!file.read(reinterpret_cast<char*>(magic), sizeof(magic))) return Format::None;
+
+    if (magic[0] == 0x1F && magic[1] == 0x8B) return Format::Gzip;
+    static const unsigned char kXz[6] = {0xFD, '7', 'z', 'X', 'Z', 0x00};
+    if (std::memcmp(magic, kXz, sizeof(kXz)) == 0) return Format::Xz;
+#if defined(HEXEDITPRO_HAVE_ZSTD)
+    if (magic[0] == 0x28 && magic[1] == 0xB5 && magic[2] == 0x2F && magic[3] == 0xFD) return Format::Zstd;
+#endif
+    return Format::None;
+}
+
+const char* CompressedSource::format_name(Format format) {
+    switch (format) {
+    case Format::Gzip: return "gzip";
+    case Format::Xz: return "xz";
+    case Format::Zstd: return "zstd";
+    default: return "raw";
+    }
+}
+
+bool CompressedSource::open(const std::string& path) {
+    m_format = detect(path);
+    if (m_format == Format::None) return false;
+    m_path = path;
+    reset();
+    return true;
+}
+
+std::uint64_t CompressedSource::size_hint() const {
+    std::uint64_t disk_size = 0;
+    std::int64_t mtime = 0;
+    std::ifstream file(m_path, std::ios::binary);
+    if (!file || !stat_file(m_path, disk_size, mtime)) return 0;
+
+    auto read_at = [&file](std::uint64_t at, unsigned char* dst, std::size_t n) {
+        file.seekg(static_cast<std::streamoff>(at));
+        return static_cast<bool>(file.read(reinterpret_cast<char*>(dst), static_cast<std::streamsize>(n)));
+    };
+
+    switch (m_format) {
+    case Format::Gzip: {
+        // ISIZE is the last member's size mod 2^32, which never exceeds the total.
+        unsigned char t[4];
+        if (disk_size < 18 || !read_at(disk_size - 4, t, sizeof(t))) return 0;
+        return static_cast<std::uint64_t>(t[0]) | static_cast<std::uint64_t>(t[1]) << 8 |
+               static_cast<std::uint64_t>(t[2]) << 16 | static_cast<std::uint64_t>(t[3]) << 24;
+    }
+    case Format::Xz: {
+        // Skip stream padding, then follow the footer back to the index.
+        std::uint64_t end = disk_size;
+        unsigned char footer[LZMA_STREAM_HEADER_SIZE];
+        for (;;) {
+            if (end < 2 * LZMA_STREAM_HEADER_SIZE || !read_at(end - sizeof(footer), footer, sizeof(footer))) return 0;
+            if (std::memcmp(footer + 8, "\0\0\0\0", 4) != 0) break;
+            end -= 4;
+        }
+        lzma_stream_flags flags{};
+        if (lzma_stream_footer_decode(&flags, footer) != LZMA_OK ||
+            flags.backward_size > end - 2 * LZMA_STREAM_HEADER_SIZE || flags.backward_size > (64u << 20))
+            return 0;
+        std::vector<unsigned char> raw(static_cast<std::size_t>(flags.backward_size));
+        if (!read_at(end - sizeof(footer) - raw.size(), raw.data(), raw.size())) return 0;
+
+        lzma_index* idx = nullptr;
+        std::uint64_t memlimit = UINT64_MAX;
+        std::size_t pos = 0;
+        if (lzma_index_buffer_decode(&idx, &memlimit, nullptr, raw.data(), &pos, raw.size()) != LZMA_OK) return 0;
+        const std::uint64_t size = lzma_index_uncompressed_size(idx);
+        lzma_index_end(idx, nullptr);
+        return size;
+    }
+    case Format::Zstd: {
+#if defined(HEXEDITPRO_HAVE_ZSTD)
+        unsigned char header[18];   // the largest frame header
+        const std::size_t n = static_cast<std::size_t>(std::min<std::uint64_t>(disk_size, sizeof(header)));
+        if (!read_at(0, header, n)) return 0;
+        const unsigned long long size = ZSTD_getFrameContentSize(header, n);
+        return size == ZSTD_CONTENTSIZE_UNKNOWN || size == ZSTD_CONTENTSIZE_ERROR ? 0 : size;
+#else
+        return 0;
+#endif
+    }
+    default:
+        return 0;
+    }
+}
+
+void CompressedSource::reset() {
+    std::lock_guard<std::mutex> lock(m_points_mutex);
+    m_points.clear();
+    m_size = 0;
+}
+
+std::size_t CompressedSource::checkpoint_count() const {
+    std::lock_guard<std::mutex> lock(m_points_mutex);
+    return m_points.size();
+}
+
+std::size_t CompressedSource::resident_bytes() const {
+    std::lock_guard<std::mutex> lock(m_points_mutex);
+    std::size_t total = 0;
+    for (const auto& cp : m_points) total += sizeof(cp) + cp.window.capacity();
+    return total;
+}
+
+bool CompressedSource::unchanged_on_disk() const {
+    std::uint64_t size = 0;
+    std::int64_t mtime = 0;
+    return stat_file(m_path, size, mtime) && size == m_disk_size && mtime == m_disk_mtime_ns;
+}
+
+const CompressedSource::Checkpoint* CompressedSource::checkpoint_before(std::uint64_t offset) const {
+    std::lock_guard<std::mutex> lock(m_points_mutex);
+    auto it = std::upper_bound(m_points.begin(), m_points.end(), offset,
+                               [](std::uint64_t v, const Checkpoint& cp) { return v < cp.out; });
+    return it == m_points.begin() ? nullptr : &*std::prev(it);
+}
+
+void CompressedSource::add_checkpoint(Checkpoint&& cp) {
+    std::lock_guard<std::mutex> lock(m_points_mutex);
+    // A resumed pass starts at the last checkpoint and may find it again.
+    if (!m_points.empty() && cp.out <= m_points.back().out) return;
+    m_points.push_back(std::move(cp));
+}
+
+bool CompressedSource::index(const Sink& sink, const std::atomic<bool>* cancel) {
+    std::uint64_t disk_size = 0;
+    std::int64_t mtime = 0;
+    if (!stat_file(m_path, disk_size, mtime)) return false;
+
+    const Checkpoint* from = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_points_mutex);
+        if (!m_points.empty()) from = &m_points.back();
+    }
+
+    std::uint64_t end = 0;
+    if (!decode(from, 0, sink, true, cancel, end)) return false;
+    if (cancelled(cancel)) return false;
+
+    m_size = end;
+    m_disk_size = disk_size;
+    m_disk_mtime_ns = mtime;
+    return true;
+}
+
+bool CompressedSource::decode(const Checkpoint* from, std::uint64_t stop, const Sink& sink, bool record,
+                              const std::atomic<bool>* cancel, std::uint64_t& out_end) {
+    switch (m_format) {
+    case Format::Gzip: return decode_gzip(from, stop, sink, record, cancel, out_end);
+    case Format::Xz: return decode_xz(from, stop, sink, record, cancel, out_end);
+    case Format::Zstd: return decode_zstd(from, stop, sink, record, cancel, out_end);
+    default: return false;
+    }
+}
+
+bool CompressedSource::decode_gzip(const Checkpoint* from, std::uint64_t stop, const Sink& sink, bool record,
+                                   const std::atomic<bool>* cancel, std::uint64_t& out_end) {
+    Input in;
+    z_stream strm{};
+    std::uint64_t out = 0;
+    bool raw = false;
+
+    if (from) {
+        // Resume mid-member: raw deflate, primed with the leftover bits and the window.
+        if (!in.open(m_path, from->in - (from->bits ? 1 : 0))) return false;
+        if (inflateInit2(&strm, -15) != Z_OK) return false;
+        raw = true;
+        if (from->bits) {
+            unsigned char c = 0;
+            if (!in.read_exact(&c, 1)) { inflateEnd(&strm); return false; }
+            inflatePrime(&strm, from->bits, c >> (8 - from->bits));
+        }
+        inflateSetDictionary(&strm, from->window.data(), static_cast<uInt>(from->window.size()));
+        out = from->out;
+    } else {
+        if (!in.open(m_path, 0)) return false;
+        if (inflateInit2(&strm, 47) != Z_OK) return false;   // gzip or zlib header
+    }
+
+    std::vector<unsigned char> window(kWindow);
+    std::uint64_t last_point = out;
+    std::size_t skip_trailer = 0;
+    bool member_done = false;
+    bool more = false;   // the last call filled the window; output may still be pending
+    bool ok = true;
+    strm.avail_out = 0;
+
+    while (!cancelled(cancel)) {
+        // End of input: complete, or a file still being written.
+        if (!in.fill() && !more) break;
+
+        if (skip_trailer) {
+            if (!in.avail()) break;
+            // CRC32 and ISIZE after a raw-decoded member; the next member has a header.
+            const std::size_t k = std::min(skip_trailer, in.avail());
+            in.consume(k);
+            if ((skip_trailer -= k) == 0) { inflateReset2(&strm, 31); raw = false; }
+            continue;
+        }
+
+        if (strm.avail_out == 0) {
+            strm.avail_out = kWindow;
+            strm.next_out = window.data();
+        }
+        const uInt avail_in = static_cast<uInt>(std::min<std::size_t>(in.avail(), UINT_MAX));
+        const uInt avail_out = strm.avail_out;
+        unsigned char* produced_at = strm.next_out;
+        strm.next_in = const_cast<Bytef*>(in.data());
+        strm.avail_in = avail_in;
+
+        const int ret = inflate(&strm, Z_BLOCK);
+        in.consume(avail_in - strm.avail_in);
+        const std::size_t produced = avail_out - strm.avail_out;
+        more = strm.avail_out == 0;
+        if (produced) {
+            sink(out, produced_at, produced);
+            out += produced;
+            member_done = false;
+        }
+
+        if (ret == Z_NEED_DICT || ret == Z_DATA_ERROR || ret == Z_MEM_ERROR) {
+            ok = member_done;   // junk after the last member is ignored
+            break;
+        }
+        if (stop && out >= stop) break;
+        if (ret == Z_STREAM_END) {
+            member_done = true;
+            if (raw) skip_trailer = 8;
+            else inflateReset(&strm);
+            continue;
+        }
+        if (ret == Z_BUF_ERROR && produced == 0 && strm.avail_in == avail_in) break;
+
+        // After a block boundary (not the final block) the state is just bits + window.
+        if (record && (strm.data_type & 128) && !(strm.data_type & 64) && out > 0 &&
+            out - last_point >= kSpacing) {
+            Checkpoint cp{out, in.pos(), strm.data_type & 7, -1, std::vector<unsigned char>(kWindow)};
+            const std::size_t left = strm.avail_out;
+            std::memcpy(cp.window.data(), window.data() + kWindow - left, left);
+            std::memcpy(cp.window.data() + left, window.data(), kWindow - left);
+            add_checkpoint(std::move(cp));
+            last_point = out;
+        }
+    }
+
+    inflateEnd(&strm);
+    out_end = out;
+    return ok;
+}
+
+bool CompressedSource::decode_xz(const Checkpoint* from, std::uint64_t stop, const Sink& sink, bool record,
+                                 const std::atomic<bool>* cancel, std::uint64_t& out_end) {
+    Input in;
+    if (!in.open(m_path, from ? from->in : 0)) return false;
+
+    std::uint64_t out = from ? from->out : 0;
+    std::uint64_t last_point = out;
+    int check = from ? from->check : -1;   // -1: expecting a stream header
+    std::vector<unsigned char> buf(kInputSize);
+    bool ok = true;
+
+    // Feeds `strm` from `in` until LZMA_STREAM_END; decoded bytes go to the sink when `emit`.
+    auto run = [&](lzma_stream& strm, bool emit) -> lzma_ret {
+        bool more = false;   // output buffer was filled; flush before asking for input
+        for (;;) {
+            if (cancelled(cancel)) return LZMA_BUF_ERROR;
+            if (strm.avail_in == 0) {
+                if (!in.fill() && !more) return LZMA_BUF_ERROR;
+                strm.next_in = in.data();
+                strm.avail_in = in.avail();
+            }
+            const std::size_t before_in = strm.avail_in;
+            strm.next_out = buf.data();
+            strm.avail_out = buf.size();
+            const lzma_ret ret = lzma_code(&strm, LZMA_RUN);
+            in.consume(before_in - strm.avail_in);
+            const std::size_t produced = buf.size() - strm.avail_out;
+            more = strm.avail_out == 0;
+            if (emit && produced) {
+                sink(out, buf.data(), produced);
+                out += produced;
+                if (stop && out >= stop) return LZMA_STREAM_END;
+            }
+            if (ret != LZMA_OK) return ret;
+        }
+    };
+
+    while (!cancelled(cancel) && !(stop && out >= stop)) {
+        if (check < 0) {
+            // Stream padding is a multiple of four zero bytes.
+            while (in.fill() && in.data()[0] == 0) in.consume(1);
+            unsigned char header[LZMA_STREAM_HEADER_SIZE];
+            if (!in.read_exact(header, sizeof(header))) break;
+            lzma_stream_flags flags{};
+            if (lzma_stream_header_decode(&flags, header) != LZMA_OK) { ok = out > 0; break; }
+            check = static_cast<int>(flags.check);
+        }
+
+        const std::uint64_t block_at = in.pos();
+        unsigned char header[LZMA_BLOCK_HEADER_SIZE_MAX];
+        if (!in.read_exact(header, 1)) break;
+
+        if (header[0] == 0) {
+            // Index indicator: skip the index and the stream footer.
+            lzma_stream strm = LZMA_STREAM_INIT;
+            lzma_index* idx = nullptr;
+            if (lzma_index_decoder(&strm, &idx, UINT64_MAX) != LZMA_OK) { ok = false; break; }
+            strm.next_in = header;
+            strm.avail_in = 1;
+            lzma_ret ret = lzma_code(&strm, LZMA_RUN);
+            if (ret == LZMA_OK) ret = run(strm, false);
+            lzma_end(&strm);
+            if (idx) lzma_index_end(idx, nullptr);
+            unsigned char footer[LZMA_STREAM_HEADER_SIZE];
+            if (ret != LZMA_STREAM_END || !in.read_exact(footer, sizeof(footer))) break;
+            check = -1;
+            continue;
+        }
+
+        if (record && out > 0 && out - last_point >= kSpacing) {
+            add_checkpoint({out, block_at, 0, check, {}});
+            last_point = out;
+        }
+
+        lzma_filter filters[LZMA_FILTERS_MAX + 1];
+        lzma_block block{};
+        block.version = 0;
+        block.check = static_cast<lzma_check>(check);
+        block.filters = filters;
+        block.header_size = lzma_block_header_size_decode(header[0]);
+        if (!in.read_exact(header + 1, block.header_size - 1)) break;
+        if (lzma_block_header_decode(&block, nullptr, header) != LZMA_OK) { ok = false; break; }
+
+        lzma_stream strm = LZMA_STREAM_INIT;
+        const lzma_ret init = lzma_block_decoder(&strm, &block);
+        for (std::size_t i = 0; filters[i].id != LZMA_VLI_UNKNOWN; ++i) std::free(filters[i].options);
+        if (init != LZMA_OK) { ok = false; break; }
+
+        const lzma_ret ret = run(strm, true);
+        lzma_end(&strm);
+        if (ret == LZMA_BUF_ERROR) break;   // truncated or cancelled
+        if (ret != LZMA_STREAM_END) { ok = false; break; }
+    }
+
+    out_end = out;
+    return ok;
+}
+
+bool CompressedSource::decode_zstd(const Checkpoint* from, std::uint64_t stop, const Sink& sink, bool record,
+                                   const std::atomic<bool>* cancel, std::uint64_t& out_end) {
+#if defined(HEXEDITPRO_HAVE_ZSTD)
+    Input in;
+    if (!in.open(m_path, from ? from->in : 0)) return false;
+
+    ZSTD_DStream* ds = ZSTD_createDStream();
+    if (!ds) return false;
+    ZSTD_initDStream(ds);
+
+    std::uint64_t out = from ? from->out : 0;
+    std::uint64_t last_point = out;
+    std::vector<unsigned char> buf(ZSTD_DStreamOutSize());
+    bool frame_start = true;
+    bool more = false;   // the output buffer was filled; flush before asking for input
+    bool ok = true;
+
+    while (!cancelled(cancel) && !(stop && out >= stop)) {
+        if (!in.fill() && !more) break;
+
+        // Frames decode independently, so every frame start is a checkpoint.
+        if (record && frame_start && out > 0 && out - last_point >= kSpacing) {
+            add_checkpoint({out, in.pos(), 0, -1, {}});
+            last_point = out;
+        }
+
+        ZSTD_inBuffer ib{in.data(), in.avail(), 0};
+        ZSTD_outBuffer ob{buf.data(), buf.size(), 0};
+        const std::size_t ret = ZSTD_decompressStream(ds, &ob, &ib);
+        in.consume(ib.pos);
+        if (ZSTD_isError(ret)) {
+            ok = frame_start;   // junk after the last frame is ignored
+            break;
+        }
+        more = ob.pos == ob.size;
+        if (ob.pos) {
+            sink(out, buf.data(), ob.pos);
+            out += ob.pos;
+        }
+        // The decoder stops at a frame boundary once the frame is fully flushed.
+        frame_start = ret == 0;
+    }
+
+    ZSTD_freeDStream(ds);
+    out_end = out;
+    return ok;
+#else
+    (void)from; (void)stop; (void)sink; (void)record; (void)cancel;
+    out_end = 0;
+    return false;
+#endif
+}
+
+bool CompressedSource::read_all(unsigned char* out) {
+    std::vector<const Checkpoint*> spans{nullptr};
+    {
+        std::lock_guard<std::mutex> lock(m_points_mutex);
+        for (const auto& cp : m_points) spans.push_back(&cp);
+    }
+
+    std::atomic<bool> ok{true};
+    WorkerPool::shared().parallel_for(spans.size(), [&](std::size_t i) {
+        const std::uint64_t end = i + 1 < spans.size() ? spans[i + 1]->out : m_size.load();
+        std::uint64_t reached = 0;
+        decode(spans[i], end,
+               [&](std::uint64_t at, const unsigned char* src, std::size_t n) {
+                   const std::uint64_t hi = std::min(at + n, end);
+                   if (at < hi) std::memcpy(out + at, src, static_cast<std::size_t>(hi - at));
+               },
+               false, nullptr, reached);
+        if (reached < end) ok = false;
+    });
+    return ok;
+}
@@ -0,0 +1,114 @@
+#include "DataInspector.hpp"
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+// Writes through the C API so no Glib::ustring is built per update.
+void set_label(Gtk::Label& label, std::array<char, ValueDecoder::kTextLen>& shown,
+               const std::array<char, ValueDecoder::kTextLen>& text) {
+    if (std::strcmp(shown.data(), text.data()) == 0) return;
+    shown = text;
+    gtk_label_set_text(label.gobj(), text.data());
+}
+
+} // namespace
+
+DataInspector::DataInspector() : Gtk::Box(Gtk::ORIENTATION_VERTICAL) {
+    m_offset_label.set_halign(Gtk::ALIGN_START);
+    m_offset_label.set_text("No data.");
+
+    m_grid.set_column_spacing(12);
+    m_grid.set_row_spacing(2);
+    m_first_title.set_markup("<b>Little Endian</b>");
+    m_second_title.set_markup("<b>Big Endian</b>");
+    m_first_title.set_halign(Gtk::ALIGN_START);
+    m_second_title.set_halign(Gtk::ALIGN_START);
+    m_grid.attach(m_first_title, 1, 0, 1, 1);
+    m_grid.attach(m_second_title, 2, 0, 1, 1);
+
+    for (int r = 0; r < ValueDecoder::kRowCount; ++r) {
+        m_names[r].set_text(ValueDecoder::row_label(static_cast<ValueDecoder::Row>(r)));
+        m_names[r].set_halign(Gtk::ALIGN_START);
+        m_first[r].set_halign(Gtk::ALIGN_START);
+        m_second[r].set_halign(Gtk::ALIGN_START);
+        m_first[r].set_selectable(true);
+        m_second[r].set_selectable(true);
+        m_grid.attach(m_names[r], 0, r + 1, 1, 1);
+        m_grid.attach(m_first[r], 1, r + 1, 1, 1);
+        m_grid.attach(m_second[r], 2, r + 1, 1, 1);
+    }
+
+    set_spacing(6);
+    pack_start(m_offset_label, Gtk::PACK_SHRINK);
+    pack_start(m_grid, Gtk::PACK_SHRINK);
+
+    // Updates that arrive while hidden are applied when the panel is shown.
+    signal_map().connect([this] { if (m_dirty) refresh(); });
+
+    show_all_children();
+}
+
+DataInspector::~DataInspector() {
+    m_timer.disconnect();
+}
+
+void DataInspector::set_buffer(const HexBuffer* buffer) {
+    m_buffer = buffer;
+    m_offset = 0;
+    schedule();
+}
+
+void DataInspector::set_cursor(std::size_t offset) {
+    m_offset = offset;
+    schedule();
+}
+
+void DataInspector::set_big_endian_first(bool big_first) {
+    if (m_big_first == big_first) return;
+    m_big_first = big_first;
+    m_first_title.set_markup(big_first ? "<b>Big Endian</b>" : "<b>Little Endian</b>");
+    m_second_title.set_markup(big_first ? "<b>Little Endian</b>" : "<b>Big Endian</b>");
+    refresh();
+}
+
+void DataInspector::schedule() {
+    m_dirty = true;
+    if (!get_mapped() || m_timer.connected()) return;
+
+    // Leading edge runs immediately; a burst of moves (held arrow key) then
+    // collapses into one trailing refresh per interval.
+    const gint64 elapsed_ms = (g_get_monotonic_time() - m_last_refresh_us) / 1000;
+    if (elapsed_ms >= kMinIntervalMs) {
+        refresh();
+        return;
+    }
+    m_timer = Glib::signal_timeout().connect(sigc::mem_fun(*this, &DataInspector::on_timer),
+                                             static_cast<unsigned>(kMinIntervalMs - elapsed_ms));
+}
+
+bool DataInspector::on_timer() {
+    if (m_dirty) refresh();
+    return false;
+}
+
+void DataInspector::refresh() {
+    m_dirty = false;
+    m_last_refresh_us = g_get_monotonic_time();
+
+    const unsigned char* data = m_buffer ? m_buffer->data.data() : nullptr;
+    const std::size_t n = m_buffer ? m_buffer->data.size() : 0;
+    ValueDecoder::decode(data, n, m_offset, m_values);
+
+    char header[48];
+    if (m_offset < n) std::snprintf(header, sizeof(header), "Offset 0x%zX (%zu)", m_offset, m_offset);
+    else std::snprintf(header, sizeof(header), "No data.");
+    gtk_label_set_text(m_offset_label.gobj(), header);
+
+    const auto& first = m_big_first ? m_values.big : m_values.little;
+    const auto& second = m_big_first ? m_values.little : m_values.big;
+    for (int r = 0; r < ValueDecoder::kRowCount; ++r) {
+        set_label(m_first[r], m_shown_first[r], first[r]);
+        set_label(m_second[r], m_shown_second[r], second[r]);
+    }
+}
@@ -0,0 +1,265 @@
+#include "Document.hpp"
+#include "WorkerPool.hpp"
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+namespace {
+constexpr std::size_t kProgressStep = 32u << 20;
+}
+
+Document::Document() {
+    scroll.add(view);
+    scroll.set_policy(Gtk::POLICY_AUTOMATIC, Gtk::POLICY_AUTOMATIC);
+    update_title();
+
+    // Inserts and deletes shift everything after them; overwrites touch only their bytes.
+    view.signal_bytes_inserted().connect([this](std::size_t at, std::size_t len) {
+        marks.on_insert(at, len);
+        search_marks.on_insert(at, len);
+        update_classes(at, buffer.data.size());
+    });
+    view.signal_bytes_erased().connect([this](std::size_t at, std::size_t len) {
+        marks.on_erase(at, len);
+        search_marks.on_erase(at, len);
+        update_classes(at, buffer.data.size());
+    });
+    view.signal_bytes_overwritten().connect([this](std::size_t at, std::size_t len) {
+        update_classes(at, at + len);
+    });
+    view.set_marks(&marks, &search_marks);
+    view.set_overview_source([this]() -> const std::vector<ByteClassMix>& { return cache.block_classes(); });
+
+    m_decode_dispatcher.connect(sigc::mem_fun(*this, &Document::on_decode_dispatch));
+
+    m_budget_id = MemoryBudget::shared().add([this] { return resident_bytes(); },
+                                             [this] { return release(); });
+}
+
+Document::~Document() {
+    cancel_load();
+    MemoryBudget::shared().remove(m_budget_id);
+}
+
+bool Document::open(const std::string& path) {
+    cancel_load();
+    if (CompressedSource::detect(path) == CompressedSource::Format::None) {
+        if (!buffer.load(path)) return false;
+        finish_open(path);
+        return true;
+    }
+
+    m_loading_path = path;
+    m_loading = true;
+    m_decoded_bytes = 0;
+    m_load_error.clear();
+    update_title();
+    // The decoded bytes are held in memory whole, so they must fit the shared budget.
+    const std::size_t limit = MemoryBudget::shared().limit();
+    m_decode_job = WorkerPool::shared().submit([this, path, limit] {
+        DecodedFile file;
+        std::size_t next_report = kProgressStep;
+        const auto report = [this, &next_report](std::size_t bytes) {
+            if (bytes < next_report) return;
+            next_report = bytes + kProgressStep;
+            m_decoded_bytes = bytes;
+            m_decode_dispatcher.emit();
+        };
+        const bool ok = HexBuffer::decode(path, file, &m_decode_cancel, report, limit);
+        {
+            std::lock_guard<std::mutex> lock(m_decode_mutex);
+            m_decoded = std::move(file);
+            m_decode_ok = ok;
+            m_decode_done = true;
+        }
+        m_decode_dispatcher.emit();
+    });
+    return true;
+}
+
+void Document::cancel_load() {
+    m_decode_cancel = true;
+    if (m_decode_job.valid()) m_decode_job.wait();
+    m_decode_cancel = false;
+
+    std::lock_guard<std::mutex> lock(m_decode_mutex);
+    m_decoded = DecodedFile{};
+    m_decode_done = false;
+    m_loading = false;
+    m_decoded_bytes = 0;
+}
+
+void Document::on_decode_dispatch() {
+    DecodedFile file;
+    bool done = false;
+    bool ok = false;
+    {
+        std::lock_guard<std::mutex> lock(m_decode_mutex);
+        done = m_decode_done;
+        if (done) {
+            file = std::move(m_decoded);
+            ok = m_decode_ok;
+            m_decode_done = false;
+        }
+    }
+    if (!m_loading) return;   // cancelled; the dispatch was already queued
+    if (!done) {
+        m_signal_load_progress.emit(m_decoded_bytes);
+        return;
+    }
+
+    if (m_decode_job.valid()) m_decode_job.get();
+    m_loading = false;
+    m_decoded_bytes = 0;
+    if (file.over_limit) {
+        std::ostringstream msg;
+        msg << "It decodes to more than the " << (MemoryBudget::shared().limit() >> 20)
+            << " MiB memory budget, and compressed files are held in memory whole. "
+               "Raise HEXEDITPRO_MEMORY_MB or decompress it to disk first.";
+        m_load_error = msg.str();
+    }
+    if (ok) {
+        buffer.adopt(m_loading_path, std::move(file));
+        finish_open(m_loading_path);
+    } else {
+        update_title();
+    }
+    m_signal_loaded.emit(ok);
+}
+
+void Document::finish_open(const std::string& path) {
+    m_modified = false;
+    m_released = false;
+    marks.clear();
+    search_marks.clear();
+    bookmark_names.clear();
+    cache.attach(path, buffer.data.data(), buffer.data.size());
+    view.update_display(buffer);
+    update_title();
+}
+
+bool Document::save(const std::string& path) {
+    if (!buffer.save(path)) return false;
+    m_modified = false;
+    cache.file_saved(path, buffer.data.data(), buffer.data.size());
+    update_title();
+    return true;
+}
+
+void Document::mark_modified() {
+    cache.mark_modified();
+    if (m_modified) return;
+    m_modified = true;
+    update_title();
+}
+
+bool Document::sync_from_disk(bool& grew) {
+    grew = false;
+    if (m_modified || m_released || buffer.current_path.empty()) return false;
+
+    const std::size_t old_size = buffer.data.size();
+    std::vector<ByteRange> changed;
+    if (!buffer.reload_changes(changed)) return false;
+    // Results are re-validated block by block the next time they are used.
+    cache.file_reloaded(buffer.disk_mtime_ns, !changed.empty());
+    if (changed.empty()) return true;
+
+    if (buffer.data.size() < old_size) {
+        marks.on_erase(buffer.data.size(), old_size - buffer.data.size());
+        search_marks.on_erase(buffer.data.size(), old_size - buffer.data.size());
+    }
+    for (const auto& r : changed) {
+        view.update_range(buffer, r.begin, r.end);
+        update_classes(r.begin, r.end);
+    }
+    grew = buffer.data.size() > old_size;
+    return true;
+}
+
+void Document::update_classes(std::size_t begin, std::size_t end) {
+    cache.update_classes(buffer.data.data(), buffer.data.size(), begin, end);
+    view.refresh_overview();
+}
+
+void Document::add_bookmark(std::size_t offset, const std::string& name) {
+    marks.insert({offset, offset + 1, MarkKind::Bookmark, static_cast<std::uint32_t>(bookmark_names.size())});
+    bookmark_names.push_back(name);
+    view.refresh_marks();
+}
+
+bool Document::find_bookmark(const std::string& name, std::size_t& offset) const {
+    // Bookmarks are few; walking every mark is cheaper than keeping a name index in step with edits.
+    std::vector<Mark> all;
+    marks.collect(all);
+    for (const Mark& m : all) {
+        if (m.kind == MarkKind::Bookmark && m.tag < bookmark_names.size() && bookmark_names[m.tag] == name) {
+            offset = m.begin;
+            return true;
+        }
+    }
+    return false;
+}
+
+void Document::add_highlight(std::size_t begin, std::size_t end, std::uint32_t color) {
+    if (begin >= end) return;
+    marks.insert({begin, end, MarkKind::Highlight, color});
+    view.refresh_marks();
+}
+
+void Document::clear_marks(MarkKind kind) {
+    if (kind == MarkKind::SearchHit) {
+        search_marks.clear();
+    } else {
+        std::vector<Mark> all, kept;
+        marks.collect(all);
+        for (const Mark& m : all)
+            if (m.kind != kind) kept.push_back(m);
+        marks.assign(kept);
+        if (kind == MarkKind::Bookmark) bookmark_names.clear();
+    }
+    view.refresh_marks();
+}
+
+std::size_t Document::resident_bytes() const {
+    return buffer.data.capacity() + m_decoded_bytes + view.text_bytes() + (buffer.source ? buffer.source->resident_bytes() : 0) +
+           marks.memory_bytes() + search_marks.memory_bytes();
+}
+
+void Document::touch() {
+    MemoryBudget::shared().touch(m_budget_id);
+}
+
+bool Document::release() {
+    // Unsaved edits and untitled buffers have nowhere to be reloaded from.
+    if (m_released || m_modified || buffer.current_path.empty()) return false;
+
+    m_saved_cursor = view.cursor_byte();
+    view.clear_display();
+    buffer.data.clear();
+    buffer.data.shrink_to_fit();
+    m_released = true;
+    return true;
+}
+
+bool Document::ensure_resident() {
+    if (!m_released) return true;
+    if (!buffer.restore()) return false;
+
+    m_released = false;
+    cache.attach(buffer.current_path, buffer.data.data(), buffer.data.size());
+    view.update_display(buffer);
+    view.scroll_to_byte(std::min(m_saved_cursor, buffer.data.empty() ? 0 : buffer.data.size() - 1));
+    return true;
+}
+
+void Document::update_title() {
+    if (m_loading) {
+        tab_label.set_text(Glib::path_get_basename(m_loading_path) + " (decoding)");
+        tab_label.set_tooltip_text(m_loading_path);
+        return;
+    }
+    const std::string name = buffer.current_path.empty() ? "Untitled"
+                                                         : Glib::path_get_basename(buffer.current_path);
+    tab_label.set_text(m_modified ? "*" + name : name);
+    tab_label.set_tooltip_text(buffer.current_path);
+}
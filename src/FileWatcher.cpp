@@ -0,0 +1,89 @@
+#include "FileWatcher.hpp"
+#include <cstdint>
+
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace {
+constexpr std::uint32_t kEvents = IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_DELETE_SELF | IN_MOVE_SELF;
+}
+
+FileWatcher::FileWatcher() {
+    m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_fd < 0) return;
+    m_io = Glib::signal_io().connect(sigc::mem_fun(*this, &FileWatcher::on_io), m_fd, Glib::IO_IN);
+}
+
+FileWatcher::~FileWatcher() {
+    m_io.disconnect();
+    m_settle.disconnect();
+    if (m_fd >= 0) ::close(m_fd);
+}
+
+bool FileWatcher::add_watch(const std::string& path, Watch& w) {
+    const int wd = inotify_add_watch(m_fd, path.c_str(), kEvents);
+    if (wd < 0) return false;
+    w.wd = wd;
+    m_paths[wd] = path;
+    return true;
+}
+
+bool FileWatcher::watch(const std::string& path) {
+    if (m_fd < 0 || path.empty()) return false;
+    Watch& w = m_watches[path];
+    ++w.refs;
+    return w.wd >= 0 || add_watch(path, w);
+}
+
+void FileWatcher::unwatch(const std::string& path) {
+    auto it = m_watches.find(path);
+    if (it == m_watches.end() || --it->second.refs > 0) return;
+    if (it->second.wd >= 0) {
+        inotify_rm_watch(m_fd, it->second.wd);
+        m_paths.erase(it->second.wd);
+    }
+    m_pending.erase(path);
+    m_watches.erase(it);
+}
+
+bool FileWatcher::on_io(Glib::IOCondition) {
+    alignas(inotify_event) char buf[4096];
+    for (;;) {
+        const ssize_t len = ::read(m_fd, buf, sizeof(buf));
+        if (len <= 0) break;
+
+        for (ssize_t off = 0; off < len;) {
+            const auto* ev = reinterpret_cast<const inotify_event*>(buf + off);
+            off += static_cast<ssize_t>(sizeof(inotify_event) + ev->len);
+
+            auto p = m_paths.find(ev->wd);
+            if (p == m_paths.end()) continue;
+            const std::string path = p->second;
+            m_pending.insert(path);
+
+            // The inode went away; the watch is dropped and re-added by path once settled.
+            if (ev->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) {
+                if (!(ev->mask & IN_IGNORED)) inotify_rm_watch(m_fd, ev->wd);
+                m_paths.erase(p);
+                auto w = m_watches.find(path);
+                if (w != m_watches.end()) w->second.wd = -1;
+            }
+        }
+    }
+
+    if (!m_pending.empty() && !m_settle.connected())
+        m_settle = Glib::signal_timeout().connect(sigc::mem_fun(*this, &FileWatcher::on_settled), kSettleMs);
+    return true;
+}
+
+bool FileWatcher::on_settled() {
+    auto pending = std::move(m_pending);
+    m_pending.clear();
+    for (const auto& path : pending) {
+        auto w = m_watches.find(path);
+        if (w == m_watches.end()) continue;
+        if (w->second.wd < 0 && !add_watch(path, w->second)) continue;   // still missing
+        m_signal_changed.emit(path);
+    }
+    return false;
+}
@@ -1,11 +1,47 @@
 #include "HexBuffer.hpp"
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <iterator>
 
+#include <sys/stat.h>
+
+namespace {
+
+bool stat_mtime(const std::string& path, std::int64_t& mtime_ns, std::size_t& size) {
+    struct stat st{};
+    if (::stat(path.c_str(), &st) != 0) return false;
+    mtime_ns = static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+    size = static_cast<std::size_t>(st.st_size);
+    return true;
+}
+
+// Writes each decoded range at its offset, growing `data` as needed.
+CompressedSource::Sink write_into(std::vector<unsigned char>& data, std::size_t& first) {
+    return [&data, &first](std::uint64_t at, const unsigned char* p, std::size_t n) {
+        const auto end = static_cast<std::size_t>(at) + n;
+        if (end > data.size()) data.resize(end);
+        std::memcpy(data.data() + at, p, n);
+        first = std::min(first, static_cast<std::size_t>(at));
+    };
+}
+
+} // namespace
+
 bool HexBuffer::load(const std::string& path) {
     std::ifstream file(path, std::ios::binary);
     if (!file) return false;
 
+    if (CompressedSource::detect(path) != CompressedSource::Format::None) {
+        DecodedFile decoded;
+        if (!decode(path, decoded)) return false;
+        adopt(path, std::move(decoded));
+        return true;
+    }
+    source.reset();
+
+    std::size_t size = 0;
+    stat_mtime(path, disk_mtime_ns, size);
     data.assign(std::istreambuf_iterator<char>(file),
                 std::istreambuf_iterator<char>());
 
@@ -13,18 +49,125 @@ bool HexBuffer::load(const std::string& path) {
     return true;
 }
 
+bool HexBuffer::decode(const std::string& path, DecodedFile& out, const std::atomic<bool>* cancel,
+                       const std::function<void(std::size_t)>& progress, std::size_t limit) {
+    auto src = std::make_shared<CompressedSource>();
+    if (!src->open(path)) return false;
+    if (limit && src->size_hint() > limit) {
+        out.over_limit = true;
+        return false;
+    }
+
+    // The decoder only polls one flag: raise it for a cancel or for the limit.
+    std::atomic<bool> stop{false};
+    std::size_t first = 0;
+    auto write = write_into(out.data, first);
+    const CompressedSource::Sink sink = [&](std::uint64_t at, const unsigned char* p, std::size_t n) {
+        if (cancel && cancel->load(std::memory_order_relaxed)) stop = true;
+        if (limit && at + n > limit) {
+            out.over_limit = true;
+            stop = true;
+        }
+        if (stop) return;
+        // Grow by doubling, but never reserve past the limit.
+        if (limit && at + n > out.data.capacity())
+            out.data.reserve(std::min(std::max(out.data.capacity() * 2, static_cast<std::size_t>(at + n)), limit));
+        write(at, p, n);
+        if (progress) progress(out.data.size());
+    };
+    if (!src->index(sink, &stop)) {
+        out.data = std::vector<unsigned char>();
+        return false;
+    }
+
+    std::size_t size = 0;
+    stat_mtime(path, out.mtime_ns, size);
+    out.source = std::move(src);
+    return true;
+}
+
+void HexBuffer::adopt(const std::string& path, DecodedFile&& file) {
+    data = std::move(file.data);
+    source = std::move(file.source);
+    disk_mtime_ns = file.mtime_ns;
+    current_path = path;
+}
+
 bool HexBuffer::save(const std::string& path) {
+    if (source && path == current_path) return false;
     std::ofstream file(path, std::ios::binary);
     if (!file) return false;
 
     file.write(reinterpret_cast<const char*>(data.data()),
                static_cast<std::streamsize>(data.size()));
+    file.close();
+    if (!file) return false;
 
+    std::size_t size = 0;
+    stat_mtime(path, disk_mtime_ns, size);
     current_path = path;
+    source.reset();
     return true;
 }
 
 void HexBuffer::clear() {
     data.clear();
     current_path.clear();
+    disk_mtime_ns = 0;
+    source.reset();
+}
+
+bool HexBuffer::restore() {
+    if (source && source->unchanged_on_disk()) {
+        data.resize(static_cast<std::size_t>(source->size()));
+        if (source->read_all(data.data())) return true;
+    }
+    return load(current_path);
+}
+
+bool HexBuffer::reload_changes(std::vector<ByteRange>& changed) {
+    std::int64_t mtime = 0;
+    std::size_t new_size = 0;
+    if (current_path.empty() || !stat_mtime(current_path, mtime, new_size)) return false;
+    if (mtime == disk_mtime_ns && new_size == data.size()) return true;
+
+    std::ifstream file(current_path, std::ios::binary);
+    if (!file) return false;
+
+    const std::size_t old_size = data.size();
+    if (source) {
+        // Growth is taken as an append and decoded from the last checkpoint; anything
+        // else means the file was rewritten and is decoded again from the start.
+        if (new_size <= source->compressed_size()) source->reset();
+        std::size_t first = old_size;
+        if (!source->index(write_into(data, first))) return false;
+        data.resize(static_cast<std::size_t>(source->size()));
+        if (first < std::max(old_size, data.size())) changed.push_back({first, std::max(old_size, data.size())});
+    } else {
+        // Compared block by block even when the file grew: writers often patch a
+        // header (RIFF size, pcapng section length, SQLite page count) in the same
+        // step as they append. Only blocks that differ are copied; the new tail
+        // never matches, since it was not loaded before.
+        data.resize(new_size);
+        std::vector<unsigned char> block(kReloadBlock);
+        for (std::size_t off = 0; off < new_size; off += kReloadBlock) {
+            const std::size_t len = std::min(kReloadBlock, new_size - off);
+            file.read(reinterpret_cast<char*>(block.data()), static_cast<std::streamsize>(len));
+            const std::size_t got = static_cast<std::size_t>(std::max<std::streamsize>(0, file.gcount()));
+            const bool known = off + got <= old_size;
+            if (got && (!known || std::memcmp(block.data(), data.data() + off, got) != 0)) {
+                std::memcpy(data.data() + off, block.data(), got);
+                if (!changed.empty() && changed.back().end == off) changed.back().end = off + got;
+                else changed.push_back({off, off + got});
+            }
+            if (got < len) {   // the file shrank under us
+                data.resize(off + got);
+                break;
+            }
+        }
+        if (data.size() < old_size) changed.push_back({data.size(), old_size});
+    }
+
+    disk_mtime_ns = mtime;
+    return true;
 }
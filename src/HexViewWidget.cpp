@@ -27,8 +27,11 @@ HexViewWidget::HexViewWidget() : Gtk::Box(Gtk::ORIENTATION_HORIZONTAL) {
     m_paned_inner.set_position(700);
 
     pack_start(m_paned_outer, Gtk::PACK_EXPAND_WIDGET);
+    pack_start(m_overview, Gtk::PACK_SHRINK);
+    m_overview.signal_jump().connect([this](std::size_t offset) { scroll_to_byte(offset); });
 
     setup_sync();
+    setup_overlay_tags();
     show_all_children();
 }
 
@@ -48,6 +51,43 @@ void HexViewWidget::setup_sync() {
         sigc::mem_fun(*this, &HexViewWidget::on_mark_set_ascii));
 }
 
+void HexViewWidget::setup_overlay_tags() {
+    // Translucent so the overlay reads on both light and dark themes.
+    static const char* kColors[StructTemplate::kColors] = {
+        "rgba(66,133,244,0.30)", "rgba(219,68,55,0.30)", "rgba(244,180,0,0.35)", "rgba(15,157,88,0.30)",
+        "rgba(171,71,188,0.30)", "rgba(0,172,193,0.30)", "rgba(255,112,67,0.30)", "rgba(158,157,36,0.35)",
+    };
+
+    m_overlay_fields.resize(kOverlayCapacity);
+    for (std::size_t i = 0; i < StructTemplate::kColors; ++i) {
+        const std::string name = "tmpl" + std::to_string(i);
+        m_hex_tags[i] = m_hex_view.get_buffer()->create_tag(name);
+        m_hex_tags[i]->property_background_rgba() = Gdk::RGBA(kColors[i]);
+        m_ascii_tags[i] = m_ascii_view.get_buffer()->create_tag(name);
+        m_ascii_tags[i]->property_background_rgba() = Gdk::RGBA(kColors[i]);
+    }
+
+    // Later tags take priority: template < search hit < highlight < bookmark.
+    static const char* kHighlights[kHighlightColors] = {
+        "rgba(255,235,59,0.55)", "rgba(129,199,132,0.55)", "rgba(100,181,246,0.55)", "rgba(240,98,146,0.55)",
+    };
+    auto add_mark_tag = [this](const std::string& name, const char* color, bool underline) {
+        for (auto* tv : {&m_hex_view, &m_ascii_view}) {
+            auto tag = tv->get_buffer()->create_tag(name);
+            tag->property_background_rgba() = Gdk::RGBA(color);
+            if (underline) tag->property_underline() = Pango::UNDERLINE_SINGLE;
+            (tv == &m_hex_view ? m_mark_hex_tags : m_mark_ascii_tags).push_back(tag);
+        }
+    };
+    add_mark_tag("hit", "rgba(255,152,0,0.45)", false);
+    for (std::size_t i = 0; i < kHighlightColors; ++i) add_mark_tag("hl" + std::to_string(i), kHighlights[i], false);
+    add_mark_tag("bookmark", "rgba(0,150,136,0.55)", true);
+
+    auto refresh = [this] { refresh_overlays(); };
+    m_scroll_hex.get_vadjustment()->signal_value_changed().connect(refresh);
+    m_scroll_ascii.get_vadjustment()->signal_value_changed().connect(refresh);
+}
+
 void HexViewWidget::on_mark_set_hex(const Gtk::TextBuffer::iterator&,
                                     const Glib::RefPtr<Gtk::TextBuffer::Mark>& mark) {
     if (!mark || mark->get_name() != "insert") return;
@@ -69,11 +109,12 @@ void HexViewWidget::sync_cursors_from(Gtk::TextView* source) {
     int line = std::max(0, it.get_line());
     int col  = std::max(0, it.get_line_offset());
 
+    const std::size_t bpl = m_layout.bytes_per_line();
     std::size_t byte_in_line = 0;
     if (source == &m_hex_view) {
-        byte_in_line = std::min<std::size_t>(kBytesPerLine - 1, static_cast<std::size_t>(col) / 3);
+        byte_in_line = m_layout.byte_from_hex_column(static_cast<std::size_t>(col));
     } else {
-        byte_in_line = std::min<std::size_t>(kBytesPerLine - 1, static_cast<std::size_t>(col));
+        byte_in_line = std::min<std::size_t>(bpl - 1, static_cast<std::size_t>(col));
     }
 
     if (source == &m_hex_view) {
@@ -83,12 +124,13 @@ void HexViewWidget::sync_cursors_from(Gtk::TextView* source) {
         m_ascii_view.scroll_to(ait);
     } else {
         auto hbuf = m_hex_view.get_buffer();
-        auto hit = hbuf->get_iter_at_line_offset(line, static_cast<int>(byte_in_line * 3));
+        auto hit = hbuf->get_iter_at_line_offset(line, static_cast<int>(m_layout.hex_column(byte_in_line)));
         hbuf->place_cursor(hit);
         m_hex_view.scroll_to(hit);
     }
 
     m_syncing = false;
+    m_signal_cursor_moved.emit(static_cast<std::size_t>(line) * bpl + byte_in_line);
 }
 
 Gtk::TextView* HexViewWidget::focused_editor() const {
@@ -105,63 +147,304 @@ void HexViewWidget::set_edit_mode(bool enable) {
 }
 
 void HexViewWidget::update_display(const HexBuffer& buffer) {
-    std::ostringstream addr_ss, hex_ss, ascii_ss;
+    m_buffer = &buffer;
+    render();
+    scroll_to_byte(0);
+    refresh_overlays();
+}
 
-    const auto& data = buffer.data;
+void HexViewWidget::render() {
+    const std::size_t n = m_buffer->data.size();
+    const std::size_t lines = (n + m_layout.bytes_per_line() - 1) / m_layout.bytes_per_line();
+    m_addr_digits = std::max<std::size_t>(8, hex_digits(n ? n - 1 : 0));
+
+    std::string addr, hex, ascii;
+    format_rows(0, lines, addr, hex, ascii);
+
+    m_addr_view.get_buffer()->set_text(addr);
+    m_hex_view.get_buffer()->set_text(hex);
+    m_ascii_view.get_buffer()->set_text(ascii);
+    m_text_bytes = addr.size() + hex.size() + ascii.size();
+    m_rendered_size = n;
+    m_tagged_last_line = -1;
+    m_marked_last_line = -1;
+}
+
+void HexViewWidget::format_rows(std::size_t first, std::size_t last,
+                                std::string& addr, std::string& hex, std::string& ascii) const {
+    const auto& data = m_buffer->data;
     const std::size_t n = data.size();
-    const std::size_t lines = (n + kBytesPerLine - 1) / kBytesPerLine;
-
-    for (std::size_t line = 0; line < lines; ++line) {
-        std::size_t base = line * kBytesPerLine;
-
-        addr_ss << std::setw(8) << std::setfill('0') << std::hex << std::uppercase << base << "\n";
-
-        for (std::size_t i = 0; i < kBytesPerLine; ++i) {
-            std::size_t idx = base + i;
-            if (idx < n) {
-                hex_ss << std::setw(2) << std::setfill('0') << std::hex << std::uppercase
-                       << static_cast<unsigned>(data[idx]);
-            } else {
-                hex_ss << "  ";
-            }
-            if (i != kBytesPerLine - 1) hex_ss << ' ';
-        }
-        hex_ss << "\n";
-
-        for (std::size_t i = 0; i < kBytesPerLine; ++i) {
-            std::size_t idx = base + i;
-            if (idx < n) {
-                unsigned char c = data[idx];
-                ascii_ss << (std::isprint(c) ? static_cast<char>(c) : '.');
-            } else {
-                ascii_ss << ' ';
-            }
+    const std::size_t bpl = m_layout.bytes_per_line();
+    const std::size_t full_lines = n / bpl;
+    const std::size_t lines = last - first;
+
+    // Every row has a fixed width, so each pane is sized once and filled in place.
+    addr.assign(lines * (m_addr_digits + 1), '\n');
+    hex.assign(lines * (m_layout.hex_line_chars() + 1), '\n');
+    ascii.assign(lines * (bpl + 1), '\n');
+
+    char* a = &addr[0];
+    char* h = &hex[0];
+    char* c = &ascii[0];
+    for (std::size_t line = first; line < last; ++line) {
+        const std::size_t base = line * bpl;
+        for (std::size_t d = m_addr_digits, v = base; d-- > 0; v >>= 4) a[d] = hexlayout::kHexDigits[v & 0x0F];
+        a += m_addr_digits + 1;
+
+        if (line < full_lines) {
+            h = m_layout.format_hex_row(data.data() + base, h) + 1;
+            c = m_layout.format_ascii_row(data.data() + base, c) + 1;
+        } else {
+            h = m_layout.format_hex_partial(data.data() + base, n - base, h) + 1;
+            c = m_layout.format_ascii_partial(data.data() + base, n - base, c) + 1;
         }
-        ascii_ss << "\n";
     }
+}
 
-    m_addr_view.get_buffer()->set_text(addr_ss.str());
-    m_hex_view.get_buffer()->set_text(hex_ss.str());
-    m_ascii_view.get_buffer()->set_text(ascii_ss.str());
+void HexViewWidget::update_range(const HexBuffer& buffer, std::size_t begin, std::size_t end) {
+    m_buffer = &buffer;
+    const std::size_t n = buffer.data.size();
+    const std::size_t old_n = m_rendered_size;
+    if (std::max<std::size_t>(8, hex_digits(n ? n - 1 : 0)) != m_addr_digits) {
+        // Addresses got wider or narrower: every row changes.
+        render();
+        refresh_overlays();
+        return;
+    }
 
-    scroll_to_byte(0);
+    const std::size_t bpl = m_layout.bytes_per_line();
+    const std::size_t old_lines = (old_n + bpl - 1) / bpl;
+    const std::size_t new_lines = (n + bpl - 1) / bpl;
+
+    std::size_t first = begin / bpl;
+    std::size_t last_old = std::min(old_lines, (end + bpl - 1) / bpl);
+    std::size_t last_new = std::min(new_lines, (end + bpl - 1) / bpl);
+    if (n != old_n) {
+        // The old last row may have been partial, and rows past it appear or vanish.
+        first = std::min(first, std::min(old_n, n) / bpl);
+        last_old = old_lines;
+        last_new = new_lines;
+    }
+    if (first >= std::max(last_old, last_new)) return;
+
+    std::string addr, hex, ascii;
+    format_rows(first, std::max(first, last_new), addr, hex, ascii);
+
+    auto replace = [first](Gtk::TextView& tv, std::size_t last, const std::string& text) {
+        auto buf = tv.get_buffer();
+        const int line_count = buf->get_line_count();
+        auto b = buf->get_iter_at_line(static_cast<int>(first));
+        auto e = static_cast<int>(last) >= line_count ? buf->end() : buf->get_iter_at_line(static_cast<int>(last));
+        auto it = buf->erase(b, e);
+        buf->insert(it, text.data(), text.data() + text.size());
+    };
+
+    m_syncing = true;
+    // Addresses only change where rows were added or removed.
+    if (new_lines != old_lines) replace(m_addr_view, old_lines, addr);
+    replace(m_hex_view, last_old, hex);
+    replace(m_ascii_view, last_old, ascii);
+    m_syncing = false;
+
+    m_text_bytes = new_lines * (m_addr_digits + 1 + m_layout.hex_line_chars() + 1 + bpl + 1);
+    m_rendered_size = n;
+    refresh_overlays();
+}
+
+std::size_t HexViewWidget::hex_digits(std::size_t v) {
+    std::size_t d = 1;
+    while (v >>= 4) ++d;
+    return d;
+}
+
+bool HexViewWidget::set_layout(std::size_t bytes_per_line, std::size_t group_size) {
+    if (bytes_per_line == m_layout.bytes_per_line() && group_size == m_layout.group_size()) return true;
+
+    const std::size_t cursor = m_buffer ? cursor_byte() : 0;
+    if (!m_layout.set(bytes_per_line, group_size)) return false;
+    if (!m_buffer) return true;
+
+    render();
+    scroll_to_byte(cursor);
+    refresh_overlays();
+    return true;
 }
 
 void HexViewWidget::clear_display() {
+    m_buffer = nullptr;
+    m_text_bytes = 0;
+    m_rendered_size = 0;
+    m_template = nullptr;
+    m_tagged_last_line = -1;
+    m_marked_last_line = -1;
     m_addr_view.get_buffer()->set_text("");
     m_hex_view.get_buffer()->set_text("");
     m_ascii_view.get_buffer()->set_text("");
 }
 
-void HexViewWidget::scroll_to_byte(std::size_t byte_index) {
-    std::size_t line = byte_index / kBytesPerLine;
-    std::size_t in_line = byte_index % kBytesPerLine;
+void HexViewWidget::set_template(const StructTemplate* tmpl, std::size_t base) {
+    m_template = (tmpl && !tmpl->empty()) ? tmpl : nullptr;
+    m_template_base = base;
+    refresh_template_overlay();
+}
+
+void HexViewWidget::clear_template() {
+    m_template = nullptr;
+    refresh_template_overlay();
+}
+
+void HexViewWidget::visible_lines(Gtk::TextView& tv, int& first, int& last) {
+    Gdk::Rectangle rect;
+    tv.get_visible_rect(rect);
+    Gtk::TextBuffer::iterator top, bottom;
+    int line_top = 0;
+    tv.get_line_at_y(top, rect.get_y(), line_top);
+    tv.get_line_at_y(bottom, rect.get_y() + rect.get_height(), line_top);
+    first = top.get_line();
+    last = bottom.get_line();
+}
+
+void HexViewWidget::refresh_template_overlay() {
+    auto hbuf = m_hex_view.get_buffer();
+    auto abuf = m_ascii_view.get_buffer();
+
+    if (m_tagged_last_line >= m_tagged_first_line) {
+        auto hs = hbuf->get_iter_at_line(m_tagged_first_line);
+        auto he = hbuf->get_iter_at_line(m_tagged_last_line);
+        he.forward_to_line_end();
+        auto as = abuf->get_iter_at_line(m_tagged_first_line);
+        auto ae = abuf->get_iter_at_line(m_tagged_last_line);
+        ae.forward_to_line_end();
+        for (std::size_t i = 0; i < StructTemplate::kColors; ++i) {
+            hbuf->remove_tag(m_hex_tags[i], hs, he);
+            abuf->remove_tag(m_ascii_tags[i], as, ae);
+        }
+        m_tagged_last_line = -1;
+    }
+    if (!m_template || !m_buffer || m_buffer->data.empty()) return;
+
+    // Both panes scroll independently; cover whatever either one shows.
+    int hf = 0, hl = 0, af = 0, al = 0;
+    visible_lines(m_hex_view, hf, hl);
+    visible_lines(m_ascii_view, af, al);
+    const int first = std::min(hf, af);
+    const int last = std::max(hl, al);
+
+    const auto& data = m_buffer->data;
+    const std::size_t bpl = m_layout.bytes_per_line();
+    const std::size_t win_begin = static_cast<std::size_t>(first) * bpl;
+    const std::size_t win_end = std::min(data.size(), static_cast<std::size_t>(last + 1) * bpl);
+
+    const std::size_t count = m_template->decode(data.data(), data.size(), m_template_base,
+                                                 win_begin, win_end,
+                                                 m_overlay_fields.data(), m_overlay_fields.size(), true);
+
+    for (std::size_t f = 0; f < count; ++f) {
+        const auto& field = m_overlay_fields[f];
+        tag_bytes(m_hex_tags[field.color], m_ascii_tags[field.color],
+                  std::max(field.offset, win_begin), std::min(field.offset + field.size, win_end));
+    }
+    m_tagged_first_line = first;
+    m_tagged_last_line = last;
+}
+
+void HexViewWidget::tag_bytes(const Glib::RefPtr<Gtk::TextTag>& hex_tag, const Glib::RefPtr<Gtk::TextTag>& ascii_tag,
+                              std::size_t begin, std::size_t end) {
+    auto hbuf = m_hex_view.get_buffer();
+    auto abuf = m_ascii_view.get_buffer();
+    const std::size_t bpl = m_layout.bytes_per_line();
+
+    while (begin < end) {
+        const std::size_t col = begin % bpl;
+        const std::size_t span = std::min(end - begin, bpl - col);
+        const int l = static_cast<int>(begin / bpl);
+
+        auto hs = hbuf->get_iter_at_line_offset(l, static_cast<int>(m_layout.hex_column(col)));
+        auto he = hbuf->get_iter_at_line_offset(l, static_cast<int>(m_layout.hex_column(col + span - 1) + 2));
+        hbuf->apply_tag(hex_tag, hs, he);
+
+        auto as = abuf->get_iter_at_line_offset(l, static_cast<int>(col));
+        auto ae = abuf->get_iter_at_line_offset(l, static_cast<int>(col + span));
+        abuf->apply_tag(ascii_tag, as, ae);
+
+        begin += span;
+    }
+}
+
+void HexViewWidget::set_marks(const MarkTree* marks, const MarkTree* hits) {
+    m_marks = marks;
+    m_hit_marks = hits;
+    refresh_mark_overlay();
+}
+
+void HexViewWidget::refresh_overlays() {
+    refresh_template_overlay();
+    refresh_mark_overlay();
+    update_overview();
+}
+
+void HexViewWidget::update_overview() {
+    m_overview.set_file_size(m_rendered_size);
+    if (m_rendered_size == 0) return;
+    int first = 0, last = 0;
+    visible_lines(m_hex_view, first, last);
+    const std::size_t bpl = m_layout.bytes_per_line();
+    m_overview.set_viewport(static_cast<std::size_t>(first) * bpl,
+                            std::min(m_rendered_size, static_cast<std::size_t>(last + 1) * bpl));
+}
 
+void HexViewWidget::refresh_mark_overlay() {
     auto hbuf = m_hex_view.get_buffer();
-    int max_line = std::max(0, hbuf->get_line_count() - 1);
-    if (static_cast<int>(line) > max_line) line = static_cast<std::size_t>(max_line);
+    auto abuf = m_ascii_view.get_buffer();
 
-    auto hit = hbuf->get_iter_at_line_offset(static_cast<int>(line), static_cast<int>(in_line * 3));
+    if (m_marked_last_line >= m_marked_first_line) {
+        auto hs = hbuf->get_iter_at_line(m_marked_first_line);
+        auto he = hbuf->get_iter_at_line(m_marked_last_line);
+        he.forward_to_line_end();
+        auto as = abuf->get_iter_at_line(m_marked_first_line);
+        auto ae = abuf->get_iter_at_line(m_marked_last_line);
+        ae.forward_to_line_end();
+        for (std::size_t i = 0; i < m_mark_hex_tags.size(); ++i) {
+            hbuf->remove_tag(m_mark_hex_tags[i], hs, he);
+            abuf->remove_tag(m_mark_ascii_tags[i], as, ae);
+        }
+        m_marked_last_line = -1;
+    }
+    if (!m_buffer || m_buffer->data.empty()) return;
+    if ((!m_marks || m_marks->empty()) && (!m_hit_marks || m_hit_marks->empty())) return;
+
+    int hf = 0, hl = 0, af = 0, al = 0;
+    visible_lines(m_hex_view, hf, hl);
+    visible_lines(m_ascii_view, af, al);
+    const int first = std::min(hf, af);
+    const int last = std::max(hl, al);
+
+    const std::size_t bpl = m_layout.bytes_per_line();
+    const std::size_t win_begin = static_cast<std::size_t>(first) * bpl;
+    const std::size_t win_end = std::min(m_rendered_size, static_cast<std::size_t>(last + 1) * bpl);
+
+    m_visible_marks.clear();
+    if (m_hit_marks) m_hit_marks->query(win_begin, win_end, m_visible_marks);
+    if (m_marks) m_marks->query(win_begin, win_end, m_visible_marks);
+
+    for (const Mark& m : m_visible_marks) {
+        std::size_t t = 0;
+        if (m.kind == MarkKind::Highlight) t = 1 + m.tag % kHighlightColors;
+        else if (m.kind == MarkKind::Bookmark) t = 1 + kHighlightColors;
+        tag_bytes(m_mark_hex_tags[t], m_mark_ascii_tags[t], std::max(m.begin, win_begin), std::min(m.end, win_end));
+    }
+    m_marked_first_line = first;
+    m_marked_last_line = last;
+}
+
+bool HexViewWidget::scroll_to_byte(std::size_t byte_index) {
+    if (byte_index >= m_rendered_size) return false;
+    const std::size_t line = byte_index / m_layout.bytes_per_line();
+    const std::size_t in_line = byte_index % m_layout.bytes_per_line();
+
+    auto hbuf = m_hex_view.get_buffer();
+
+    auto hit = hbuf->get_iter_at_line_offset(static_cast<int>(line), static_cast<int>(m_layout.hex_column(in_line)));
     hbuf->place_cursor(hit);
     m_hex_view.scroll_to(hit);
 
@@ -169,6 +452,33 @@ void HexViewWidget::scroll_to_byte(std::size_t byte_index) {
     auto ait = abuf->get_iter_at_line_offset(static_cast<int>(line), static_cast<int>(in_line));
     abuf->place_cursor(ait);
     m_ascii_view.scroll_to(ait);
+    return true;
+}
+
+bool HexViewWidget::select_bytes(std::size_t start, std::size_t end) {
+    if (!m_buffer || start >= end || end > m_rendered_size) return false;
+    scroll_to_byte(start);
+
+    const std::size_t bpl = m_layout.bytes_per_line();
+    const std::size_t last = end - 1;
+    auto at = [](const Glib::RefPtr<Gtk::TextBuffer>& buf, std::size_t line, std::size_t col) {
+        return buf->get_iter_at_line_offset(static_cast<int>(line), static_cast<int>(col));
+    };
+
+    m_syncing = true;
+    auto hbuf = m_hex_view.get_buffer();
+    hbuf->select_range(at(hbuf, start / bpl, m_layout.hex_column(start % bpl)),
+                       at(hbuf, last / bpl, m_layout.hex_column(last % bpl) + 2));
+    auto abuf = m_ascii_view.get_buffer();
+    abuf->select_range(at(abuf, start / bpl, start % bpl), at(abuf, last / bpl, last % bpl + 1));
+    m_syncing = false;
+    return true;
+}
+
+std::size_t HexViewWidget::cursor_byte() const {
+    Gtk::TextView* tv = focused_editor();
+    auto buf = tv->get_buffer();
+    return iter_to_byte_offset(*tv, buf->get_iter_at_mark(buf->get_insert()));
 }
 
 std::size_t HexViewWidget::iter_to_byte_offset(const Gtk::TextView& tv,
@@ -176,14 +486,15 @@ std::size_t HexViewWidget::iter_to_byte_offset(const Gtk::TextView& tv,
     int line = std::max(0, it.get_line());
     int col  = std::max(0, it.get_line_offset());
 
+    const std::size_t bpl = m_layout.bytes_per_line();
     std::size_t byte_in_line = 0;
     if (&tv == &m_hex_view) {
-        byte_in_line = std::min<std::size_t>(kBytesPerLine - 1, static_cast<std::size_t>(col) / 3);
+        byte_in_line = m_layout.byte_from_hex_column(static_cast<std::size_t>(col));
     } else {
-        byte_in_line = std::min<std::size_t>(kBytesPerLine - 1, static_cast<std::size_t>(col));
+        byte_in_line = std::min<std::size_t>(bpl - 1, static_cast<std::size_t>(col));
     }
 
-    return static_cast<std::size_t>(line) * kBytesPerLine + byte_in_line;
+    return static_cast<std::size_t>(line) * bpl + byte_in_line;
 }
 
 bool HexViewWidget::get_selected_byte_range(std::size_t& start, std::size_t& end) const {
@@ -264,6 +575,7 @@ bool HexViewWidget::cut_bytes(HexBuffer& buffer) {
 
     buffer.data.erase(buffer.data.begin() + static_cast<long>(start),
                       buffer.data.begin() + static_cast<long>(end));
+    m_signal_bytes_erased.emit(start, end - start);
     return true;
 }
 
@@ -297,8 +609,10 @@ bool HexViewWidget::paste_insert(HexBuffer& buffer) {
     if (end > start) {
         buffer.data.erase(buffer.data.begin() + static_cast<long>(start),
                           buffer.data.begin() + static_cast<long>(end));
+        m_signal_bytes_erased.emit(start, end - start);
     }
     buffer.data.insert(buffer.data.begin() + static_cast<long>(start), bytes.begin(), bytes.end());
+    m_signal_bytes_inserted.emit(start, bytes.size());
     return true;
 }
 
@@ -330,6 +644,7 @@ bool HexViewWidget::paste_overwrite(HexBuffer& buffer) {
 
     std::size_t max_write = std::min<std::size_t>(bytes.size(), buffer.data.size() - start);
     for (std::size_t i = 0; i < max_write; ++i) buffer.data[start + i] = bytes[i];
+    m_signal_bytes_overwritten.emit(start, max_write);
     return true;
 }
 
@@ -340,6 +655,7 @@ bool HexViewWidget::fill_selection(HexBuffer& buffer, unsigned char value) {
     end = std::min(end, buffer.data.size());
 
     for (std::size_t i = start; i < end; ++i) buffer.data[i] = value;
+    m_signal_bytes_overwritten.emit(start, end - start);
     return true;
 }
 
@@ -1,4 +1,5 @@
 #include "MainWindow.hpp"
+#include "OffsetExpr.hpp"
 #include <algorithm>
 #include <array>
 #include <cctype>
@@ -16,9 +17,35 @@ MainWindow::MainWindow() {
 
     m_vbox.pack_start(m_menu_bar, Gtk::PACK_SHRINK);
 
-    m_scroll.add(m_hex_display);
-    m_scroll.set_policy(Gtk::POLICY_AUTOMATIC, Gtk::POLICY_AUTOMATIC);
-    m_vbox.pack_start(m_scroll, Gtk::PACK_EXPAND_WIDGET);
+    // Each open file is a notebook page; the side panels follow the active page.
+    m_tabs.set_scrollable(true);
+    m_tab_switched = m_tabs.signal_switch_page().connect(sigc::mem_fun(*this, &MainWindow::on_tab_switched));
+    m_watcher.signal_changed().connect(sigc::mem_fun(*this, &MainWindow::on_file_changed));
+
+    // Tool panels live in a notebook to the right; hidden until a panel is requested.
+    m_side_panels.append_page(m_strings_panel, "Strings");
+    m_side_panels.append_page(m_search_panel, "Search");
+    m_side_panels.append_page(m_template_panel, "Template");
+    m_side_panels.append_page(m_inspector, "Inspector");
+    m_side_panels.set_no_show_all(true);
+    m_strings_panel.signal_offset_activated().connect(
+        sigc::mem_fun(*this, &MainWindow::on_string_activated));
+    m_search_panel.signal_match_activated().connect(
+        sigc::mem_fun(*this, &MainWindow::on_search_match_activated));
+    m_search_panel.signal_results_ready().connect(
+        sigc::mem_fun(*this, &MainWindow::on_search_results_ready));
+
+    m_template_panel.signal_apply_requested().connect(
+        sigc::mem_fun(*this, &MainWindow::on_template_apply_requested));
+    m_template_panel.signal_template_changed().connect(
+        sigc::mem_fun(*this, &MainWindow::on_template_changed));
+    m_template_panel.signal_offset_activated().connect(
+        sigc::mem_fun(*this, &MainWindow::on_template_field_activated));
+
+    m_main_paned.pack1(m_tabs, true, false);
+    m_main_paned.pack2(m_side_panels, false, true);
+    m_main_paned.set_position(860);
+    m_vbox.pack_start(m_main_paned, Gtk::PACK_EXPAND_WIDGET);
 
     m_vbox.pack_start(m_statusbar, Gtk::PACK_SHRINK);
 
@@ -26,14 +53,40 @@ MainWindow::MainWindow() {
 
     apply_theme();
     show_all_children();
+
+    activate_document(add_document());
 }
 
-MainWindow::~MainWindow() = default;
+MainWindow::~MainWindow() {
+    // Panels hold pointers into the documents; unbind them before the tabs go away.
+    m_strings_panel.set_buffer(nullptr);
+    m_strings_panel.set_cache(nullptr);
+    m_search_panel.set_buffer(nullptr);
+    m_search_panel.set_cache(nullptr);
+    m_template_panel.set_buffer(nullptr);
+    m_inspector.set_buffer(nullptr);
+    m_active = nullptr;
+
+    m_tab_switched.disconnect();
+    for (auto& d : m_documents) {
+        if (!d->buffer.current_path.empty()) m_watcher.unwatch(d->buffer.current_path);
+        m_tabs.remove_page(d->scroll);
+    }
+    m_documents.clear();
+}
 
 void MainWindow::status(const std::string& msg) {
     m_statusbar.push(msg);
 }
 
+void MainWindow::show_side_panel(Gtk::Widget& page) {
+    page.show_all();
+    if (auto* tab = m_side_panels.get_tab_label(page)) tab->show();
+    m_side_panels.show();
+    int idx = m_side_panels.page_num(page);
+    if (idx >= 0) m_side_panels.set_current_page(idx);
+}
+
 void MainWindow::apply_theme() {
     const char* css_light =
         "window { background: #F5F6F7; }"
@@ -79,6 +132,8 @@ void MainWindow::setup_complex_menus() {
                 item->signal_activate().connect(sigc::mem_fun(*this, &MainWindow::on_file_save));
             else if (i_def.label == "Save As...")
                 item->signal_activate().connect(sigc::mem_fun(*this, &MainWindow::on_file_save_as));
+            else if (i_def.label == "Close")
+                item->signal_activate().connect(sigc::mem_fun(*this, &MainWindow::on_file_close));
             else if (i_def.label == "Quit")
                 item->signal_activate().connect(sigc::mem_fun(*this, &MainWindow::on_file_quit));
 
@@ -102,11 +157,57 @@ void MainWindow::setup_complex_menus() {
             else if (i_def.label == "Select All")
                 item->signal_activate().connect(sigc::mem_fun(*this, &MainWindow::on_edit_select_all));
 
+            // View
+            else if (i_def.label == "Little Endian")
+                item->signal_activate().connect(sigc::mem_fun(*this, &MainWindow::on_view_little_endian));
+            else if (i_def.label == "Big Endian")
+                item->signal_activate().connect(sigc::mem_fun(*this, &MainWindow::on_view_big_endian));
+            else if (i_def.label == "Data Inspector")
+                item->signal_activate().connect(sigc::mem_fun(*this, &MainWindow::on_view_inspector));
+            else if (i_def.label == "8 Bytes per Row")
+                item->signal_activate().connect(sigc::bind(sigc::mem_fun(*this, &MainWindow::on_view_row_width), 8));
+            else if (i_def.label == "16 Bytes per Row")
+                item->signal_activate().connect(sigc::bind(sigc::mem_fun(*this, &MainWindow::on_view_row_width), 16));
+            else if (i_def.label == "32 Bytes per Row")
+                item->signal_activate().connect(sigc::bind(sigc::mem_fun(*this, &MainWindow::on_view_row_width), 32));
+            else if (i_def.label == "64 Bytes per Row")
+                item->signal_activate().connect(sigc::bind(sigc::mem_fun(*this, &MainWindow::on_view_row_width), 64));
+            else if (i_def.label == "Group by 1 Byte")
+                item->signal_activate().connect(sigc::bind(sigc::mem_fun(*this, &MainWindow::on_view_group_size), 1));
+            else if (i_def.label == "Group by 2 Bytes")
+                item->signal_activate().connect(sigc::bind(sigc::mem_fun(*this, &MainWindow::on_view_group_size), 2));
+            else if (i_def.label == "Group by 4 Bytes")
+                item->signal_activate().connect(sigc::bind(sigc::mem_fun(*this, &MainWindow::on_view_group_size), 4));
+            else if (i_def.label == "Group by 8 Bytes")
+                item->signal_activate().connect(sigc::bind(sigc::mem_fun(*this, &MainWindow::on_view_group_size), 8));
+
             // Search / Analysis / Help
             else if (i_def.label == "Find Bytes...")
                 item->signal_activate().connect(sigc::mem_fun(*this, &MainWindow::on_search_find_bytes));
+            else if (i_def.label == "Find Text...")
+                item->signal_activate().connect(sigc::mem_fun(*this, &MainWindow::on_search_find_text));
+            else if (i_def.label == "Go To Offset...")
+                item->signal_activate().connect(sigc::mem_fun(*this, &MainWindow::on_search_goto));
+            else if (i_def.label == "Add Bookmark...")
+                item->signal_activate().connect(sigc::mem_fun(*this, &MainWindow::on_search_add_bookmark));
+            else if (i_def.label == "Next Bookmark")
+                item->signal_activate().connect(sigc::bind(sigc::mem_fun(*this, &MainWindow::on_search_bookmark_step), true));
+            else if (i_def.label == "Previous Bookmark")
+                item->signal_activate().connect(sigc::bind(sigc::mem_fun(*this, &MainWindow::on_search_bookmark_step), false));
+            else if (i_def.label == "Highlight Selection")
+                item->signal_activate().connect(sigc::mem_fun(*this, &MainWindow::on_search_highlight_selection));
+            else if (i_def.label == "Clear Highlights")
+                item->signal_activate().connect(sigc::bind(sigc::mem_fun(*this, &MainWindow::on_search_clear_marks), MarkKind::Highlight));
+            else if (i_def.label == "Clear Search Marks")
+                item->signal_activate().connect(sigc::bind(sigc::mem_fun(*this, &MainWindow::on_search_clear_marks), MarkKind::SearchHit));
             else if (i_def.label == "Byte Frequency")
                 item->signal_activate().connect(sigc::mem_fun(*this, &MainWindow::on_analysis_frequency));
+            else if (i_def.label == "Entropy")
+                item->signal_activate().connect(sigc::mem_fun(*this, &MainWindow::on_analysis_entropy));
+            else if (i_def.label == "Strings...")
+                item->signal_activate().connect(sigc::mem_fun(*this, &MainWindow::on_analysis_strings));
+            else if (i_def.label == "Structure Template...")
+                item->signal_activate().connect(sigc::mem_fun(*this, &MainWindow::on_analysis_template));
             else if (i_def.label == "About")
                 item->signal_activate().connect(sigc::mem_fun(*this, &MainWindow::on_help_about));
             else {
@@ -135,14 +236,142 @@ void MainWindow::setup_complex_menus() {
         dark_item->set_active(m_dark_mode);
         dark_item->signal_toggled().connect(sigc::mem_fun(*this, &MainWindow::on_view_theme_toggle));
         view_sub->append(*dark_item);
+
+        auto* follow_item = Gtk::make_managed<Gtk::CheckMenuItem>("Follow Tail");
+        follow_item->set_active(m_follow_tail);
+        follow_item->signal_toggled().connect(sigc::mem_fun(*this, &MainWindow::on_view_follow_tail));
+        view_sub->append(*follow_item);
         break;
     }
 }
 
+// ---------------- Tabs ----------------
+Document& MainWindow::add_document() {
+    m_documents.push_back(std::make_unique<Document>());
+    Document& doc = *m_documents.back();
+    if (m_active) doc.view.set_layout(m_active->view.layout().bytes_per_line(), m_active->view.layout().group_size());
+
+    Document* d = &doc;
+    doc.view.signal_cursor_moved().connect([this, d](std::size_t offset) {
+        if (d == m_active) m_inspector.set_cursor(offset);
+    });
+    doc.signal_load_progress().connect([this, d](std::size_t bytes) {
+        if (d == m_active) status("Decoding " + d->loading_path() + ": " + std::to_string(bytes >> 20) + " MiB so far...");
+    });
+    doc.signal_loaded().connect([this, d](bool ok) { on_document_loaded(*d, ok); });
+
+    doc.scroll.show_all();
+    doc.tab_label.show();
+    m_tabs.append_page(doc.scroll, doc.tab_label);
+    return doc;
+}
+
+void MainWindow::activate_document(Document& doc) {
+    const int idx = m_tabs.page_num(doc.scroll);
+    if (idx >= 0) m_tabs.set_current_page(idx);
+    bind_document(doc);
+}
+
+void MainWindow::on_tab_switched(Gtk::Widget* page, guint) {
+    for (auto& d : m_documents) {
+        if (&d->scroll != page) continue;
+        bind_document(*d);
+        return;
+    }
+}
+
+void MainWindow::bind_document(Document& doc) {
+    if (m_active == &doc) return;
+    if (m_active) m_active->view.clear_template();
+    m_active = &doc;
+    doc.touch();
+
+    if (!doc.ensure_resident()) status("Could not reload " + doc.buffer.current_path);
+
+    m_strings_panel.set_buffer(&doc.buffer);
+    m_strings_panel.set_cache(&doc.cache);
+    m_search_panel.set_buffer(&doc.buffer);
+    m_search_panel.set_cache(&doc.cache);
+    m_template_panel.set_buffer(&doc.buffer);
+    m_template_panel.clear();
+    m_inspector.set_buffer(&doc.buffer);
+    m_inspector.set_cursor(doc.view.cursor_byte());
+
+    enforce_memory_budget();
+}
+
+void MainWindow::close_document(Document& doc) {
+    if (&doc == m_active) {
+        m_strings_panel.set_buffer(nullptr);
+        m_strings_panel.set_cache(nullptr);
+        m_search_panel.set_buffer(nullptr);
+        m_search_panel.set_cache(nullptr);
+        m_template_panel.set_buffer(nullptr);
+        m_inspector.set_buffer(nullptr);
+        m_active = nullptr;
+    }
+
+    if (!doc.buffer.current_path.empty()) m_watcher.unwatch(doc.buffer.current_path);
+
+    // Removing the current page switches to a neighbour, which rebinds the panels.
+    m_tabs.remove_page(doc.scroll);
+    m_documents.erase(std::remove_if(m_documents.begin(), m_documents.end(),
+                                     [&doc](const std::unique_ptr<Document>& d) { return d.get() == &doc; }),
+                      m_documents.end());
+
+    if (m_documents.empty()) add_document();
+    if (!m_active) {
+        const int idx = std::max(0, m_tabs.get_current_page());
+        activate_document(*m_documents[static_cast<std::size_t>(std::min<int>(idx, static_cast<int>(m_documents.size()) - 1))]);
+    }
+}
+
+void MainWindow::enforce_memory_budget() {
+    auto& budget = MemoryBudget::shared();
+    const std::size_t freed = budget.enforce(m_active ? m_active->budget_id() : 0);
+    if (freed == 0) return;
+
+    std::ostringstream ss;
+    ss << "Released " << (freed >> 20) << " MiB from idle tabs (budget " << (budget.limit() >> 20) << " MiB).";
+    status(ss.str());
+}
+
+void MainWindow::on_file_changed(const std::string& path) {
+    for (auto& d : m_documents) {
+        Document& doc = *d;
+        if (doc.buffer.current_path != path || doc.released()) continue;   // released tabs re-read on show
+        if (doc.modified()) {
+            status(path + " changed on disk; keeping unsaved edits.");
+            continue;
+        }
+
+        const bool active = &doc == m_active;
+        if (active) {
+            // A running scan reads the old bytes.
+            m_strings_panel.invalidate();
+            m_search_panel.invalidate();
+        }
+
+        bool grew = false;
+        if (!doc.sync_from_disk(grew)) {
+            status("Could not re-read " + path);
+            continue;
+        }
+        if (!active) continue;
+
+        m_template_panel.refresh();
+        if (m_follow_tail && grew) doc.view.scroll_to_byte(doc.buffer.data.size() - 1);
+        m_inspector.set_cursor(doc.view.cursor_byte());
+
+        std::ostringstream ss;
+        ss << "Reloaded " << Glib::path_get_basename(path) << " (" << doc.buffer.data.size() << " bytes)";
+        status(ss.str());
+    }
+}
+
 // ---------------- File ----------------
 void MainWindow::on_file_new() {
-    m_buffer.clear();
-    m_hex_display.clear_display();
+    activate_document(add_document());
     status("New buffer.");
 }
 
@@ -154,28 +383,74 @@ void MainWindow::on_file_open() {
     if (dialog.run() != Gtk::RESPONSE_OK) return;
 
     const auto path = dialog.get_filename();
-    if (!m_buffer.load(path)) {
+    Document* previous = m_active;
+    Document& doc = add_document();
+    if (!doc.open(path)) {
+        close_document(doc);
         Gtk::MessageDialog err(*this, "Failed to open file.", false, Gtk::MESSAGE_ERROR, Gtk::BUTTONS_OK, true);
         err.set_secondary_text(path);
         err.run();
         return;
     }
-    m_hex_display.update_display(m_buffer);
-    status("Loaded: " + path);
+    activate_document(doc);
+    // An untouched "Untitled" tab is replaced rather than left behind.
+    if (previous && previous->empty() && !previous->modified()) close_document(*previous);
+
+    // Compressed files finish in on_document_loaded() and are watched from then on.
+    if (doc.loading()) {
+        status("Decoding " + path + "...");
+        return;
+    }
+    m_watcher.watch(path);
+    if (doc.cache.was_fresh())
+        status("Loaded: " + path + " (analysis cache up to date)");
+    else
+        status("Loaded: " + path + " (" + std::to_string(doc.cache.dirty_blocks()) + " blocks indexed)");
+}
+
+void MainWindow::on_document_loaded(Document& doc, bool ok) {
+    const std::string path = doc.loading_path();
+    if (!ok) {
+        // This runs inside the document's own dispatcher; close it once that has returned.
+        Document* d = &doc;
+        const std::string detail = doc.load_error().empty() ? path : path + "\n\n" + doc.load_error();
+        Glib::signal_idle().connect_once([this, d, detail] {
+            for (auto& p : m_documents)
+                if (p.get() == d) { close_document(*d); break; }
+            Gtk::MessageDialog err(*this, "Failed to open file.", false, Gtk::MESSAGE_ERROR, Gtk::BUTTONS_OK, true);
+            err.set_secondary_text(detail);
+            err.run();
+        });
+        return;
+    }
+    m_watcher.watch(path);
+
+    if (&doc == m_active) {
+        // The panels were bound to the still-empty buffer while it decoded.
+        m_strings_panel.invalidate();
+        m_search_panel.invalidate();
+        m_template_panel.refresh();
+        m_inspector.set_cursor(doc.view.cursor_byte());
+    }
+    status("Loaded: " + path + " (" + CompressedSource::format_name(doc.buffer.source->format()) + ", " +
+           std::to_string(doc.buffer.data.size()) + " bytes decoded, " +
+           std::to_string(doc.buffer.source->checkpoint_count()) + " seek points)");
 }
 
 void MainWindow::on_file_save() {
-    if (m_buffer.current_path.empty()) {
+    // Compressed inputs are saved decompressed, so never over the original.
+    if (m_active->buffer.current_path.empty() || m_active->buffer.source) {
         on_file_save_as();
         return;
     }
-    if (!m_buffer.save(m_buffer.current_path)) {
+    const std::string path = m_active->buffer.current_path;
+    if (!m_active->save(path)) {
         Gtk::MessageDialog err(*this, "Failed to save file.", false, Gtk::MESSAGE_ERROR, Gtk::BUTTONS_OK, true);
-        err.set_secondary_text(m_buffer.current_path);
+        err.set_secondary_text(path);
         err.run();
         return;
     }
-    status("Saved: " + m_buffer.current_path);
+    status("Saved: " + path);
 }
 
 void MainWindow::on_file_save_as() {
@@ -187,15 +462,30 @@ void MainWindow::on_file_save_as() {
     if (dialog.run() != Gtk::RESPONSE_OK) return;
 
     const auto path = dialog.get_filename();
-    if (!m_buffer.save(path)) {
+    const std::string old_path = m_active->buffer.current_path;
+    if (!m_active->save(path)) {
         Gtk::MessageDialog err(*this, "Failed to save file.", false, Gtk::MESSAGE_ERROR, Gtk::BUTTONS_OK, true);
         err.set_secondary_text(path);
         err.run();
         return;
     }
+    if (path != old_path) {
+        if (!old_path.empty()) m_watcher.unwatch(old_path);
+        m_watcher.watch(path);
+    }
     status("Saved: " + path);
 }
 
+void MainWindow::on_file_close() {
+    if (m_active->modified()) {
+        Gtk::MessageDialog ask(*this, "Discard unsaved changes?", false, Gtk::MESSAGE_QUESTION, Gtk::BUTTONS_OK_CANCEL, true);
+        ask.set_secondary_text(m_active->tab_label.get_text());
+        if (ask.run() != Gtk::RESPONSE_OK) return;
+    }
+    close_document(*m_active);
+    status("Tab closed.");
+}
+
 void MainWindow::on_file_quit() {
     hide();
 }
@@ -205,41 +495,57 @@ void MainWindow::on_edit_undo() { status("Undo: not implemented yet."); }
 void MainWindow::on_edit_redo() { status("Redo: not implemented yet."); }
 
 void MainWindow::on_edit_copy_bytes() {
-    if (m_buffer.data.empty()) { status("Nothing to copy."); return; }
-    if (!m_hex_display.copy_bytes_to_clipboard(m_buffer)) { status("Copy: no selection."); return; }
+    if (m_active->buffer.data.empty()) { status("Nothing to copy."); return; }
+    if (!m_active->view.copy_bytes_to_clipboard(m_active->buffer)) { status("Copy: no selection."); return; }
     status("Copied bytes.");
 }
 
 void MainWindow::on_edit_cut_bytes() {
-    if (m_buffer.data.empty()) { status("Nothing to cut."); return; }
-    if (!m_hex_display.cut_bytes(m_buffer)) { status("Cut: no selection."); return; }
-    m_hex_display.update_display(m_buffer);
+    if (m_active->buffer.data.empty()) { status("Nothing to cut."); return; }
+    m_strings_panel.invalidate();
+    m_search_panel.invalidate();
+    if (!m_active->view.cut_bytes(m_active->buffer)) { status("Cut: no selection."); return; }
+    m_active->mark_modified();
+    m_active->view.update_display(m_active->buffer);
+    m_template_panel.refresh();
     status("Cut bytes.");
 }
 
 void MainWindow::on_edit_paste_insert() {
-    if (m_buffer.data.empty()) { status("Paste: load a file first."); return; }
-    if (!m_hex_display.paste_insert(m_buffer)) { status("Paste Insert failed (clipboard format?)."); return; }
-    m_hex_display.update_display(m_buffer);
+    if (m_active->buffer.data.empty()) { status("Paste: load a file first."); return; }
+    m_strings_panel.invalidate();
+    m_search_panel.invalidate();
+    if (!m_active->view.paste_insert(m_active->buffer)) { status("Paste Insert failed (clipboard format?)."); return; }
+    m_active->mark_modified();
+    m_active->view.update_display(m_active->buffer);
+    m_template_panel.refresh();
     status("Paste Insert complete.");
 }
 
 void MainWindow::on_edit_paste_overwrite() {
-    if (m_buffer.data.empty()) { status("Paste: load a file first."); return; }
-    if (!m_hex_display.paste_overwrite(m_buffer)) { status("Paste Overwrite failed (clipboard format?)."); return; }
-    m_hex_display.update_display(m_buffer);
+    if (m_active->buffer.data.empty()) { status("Paste: load a file first."); return; }
+    m_strings_panel.invalidate();
+    m_search_panel.invalidate();
+    if (!m_active->view.paste_overwrite(m_active->buffer)) { status("Paste Overwrite failed (clipboard format?)."); return; }
+    m_active->mark_modified();
+    m_active->view.update_display(m_active->buffer);
+    m_template_panel.refresh();
     status("Paste Overwrite complete.");
 }
 
 void MainWindow::on_edit_zero_selection() {
-    if (m_buffer.data.empty()) { status("Nothing to modify."); return; }
-    if (!m_hex_display.fill_selection(m_buffer, 0x00)) { status("Zero: no selection."); return; }
-    m_hex_display.update_display(m_buffer);
+    if (m_active->buffer.data.empty()) { status("Nothing to modify."); return; }
+    m_strings_panel.invalidate();
+    m_search_panel.invalidate();
+    if (!m_active->view.fill_selection(m_active->buffer, 0x00)) { status("Zero: no selection."); return; }
+    m_active->mark_modified();
+    m_active->view.update_display(m_active->buffer);
+    m_template_panel.refresh();
     status("Selection zeroed.");
 }
 
 void MainWindow::on_edit_fill_selection() {
-    if (m_buffer.data.empty()) { status("Nothing to modify."); return; }
+    if (m_active->buffer.data.empty()) { status("Nothing to modify."); return; }
 
     Gtk::Dialog dlg("Fill Selection", *this);
     dlg.add_button("Cancel", Gtk::RESPONSE_CANCEL);
@@ -269,16 +575,20 @@ void MainWindow::on_edit_fill_selection() {
     iss >> std::hex >> v;
     if (v > 0xFFu) { status("Fill: invalid value."); return; }
 
-    if (!m_hex_display.fill_selection(m_buffer, static_cast<unsigned char>(v))) {
+    m_strings_panel.invalidate();
+    m_search_panel.invalidate();
+    if (!m_active->view.fill_selection(m_active->buffer, static_cast<unsigned char>(v))) {
         status("Fill: no selection.");
         return;
     }
-    m_hex_display.update_display(m_buffer);
+    m_active->mark_modified();
+    m_active->view.update_display(m_active->buffer);
+    m_template_panel.refresh();
     status("Selection filled.");
 }
 
 void MainWindow::on_edit_select_all() {
-    m_hex_display.select_all();
+    m_active->view.select_all();
     status("Selected all.");
 }
 
@@ -289,10 +599,258 @@ void MainWindow::on_view_theme_toggle() {
     status(m_dark_mode ? "Dark mode enabled." : "Light mode enabled.");
 }
 
+void MainWindow::on_view_follow_tail() {
+    m_follow_tail = !m_follow_tail;
+    if (m_follow_tail && !m_active->buffer.data.empty())
+        m_active->view.scroll_to_byte(m_active->buffer.data.size() - 1);
+    status(m_follow_tail ? "Following the end of growing files." : "Follow tail off.");
+}
+
+void MainWindow::on_view_little_endian() {
+    m_inspector.set_big_endian_first(false);
+    status("Inspector: little endian first.");
+}
+
+void MainWindow::on_view_big_endian() {
+    m_inspector.set_big_endian_first(true);
+    status("Inspector: big endian first.");
+}
+
+void MainWindow::on_view_row_width(std::size_t bytes) {
+    const std::size_t group = std::min(m_active->view.layout().group_size(), bytes);
+    if (!m_active->view.set_layout(bytes, group)) { status("Unsupported row width."); return; }
+    status(std::to_string(bytes) + " bytes per row.");
+}
+
+void MainWindow::on_view_group_size(std::size_t group) {
+    if (!m_active->view.set_layout(m_active->view.layout().bytes_per_line(), group)) {
+        status("Unsupported byte grouping.");
+        return;
+    }
+    status("Grouping hex by " + std::to_string(group) + (group == 1 ? " byte." : " bytes."));
+}
+
+void MainWindow::on_view_inspector() {
+    show_side_panel(m_inspector);
+    m_inspector.set_cursor(m_active->view.cursor_byte());
+}
+
 // ---------------- Search / Analysis / Help (leave your existing versions or re-add) ----------------
 void MainWindow::on_search_find_bytes() { status("Search: hook up your existing find logic here."); }
+
+void MainWindow::on_search_find_text() {
+    show_side_panel(m_search_panel);
+    m_search_panel.focus_query();
+    status("Search: text or regex, ASCII or UTF-16; Enter to search.");
+}
+
+void MainWindow::on_search_goto() {
+    if (m_active->buffer.data.empty()) { status("Go To: load a file first."); return; }
+    Document& doc = *m_active;
+
+    OffsetContext ctx;
+    ctx.data = doc.buffer.data.data();
+    ctx.size = doc.buffer.data.size();
+    ctx.cursor = doc.view.cursor_byte();
+    ctx.lookup = [&doc](const std::string& name, std::size_t& offset) { return doc.find_bookmark(name, offset); };
+
+    Gtk::Dialog dlg("Go To Offset", *this);
+    dlg.add_button("Cancel", Gtk::RESPONSE_CANCEL);
+    dlg.add_button("Go", Gtk::RESPONSE_OK);
+
+    auto* box = dlg.get_content_area();
+    Gtk::Label label("Offset or expression, e.g. 0x1F00, end-0x200, +0x40, mybookmark+u32(0x3C):");
+    label.set_halign(Gtk::ALIGN_START);
+    Gtk::Entry entry;
+    entry.set_text(m_last_goto);
+    entry.set_activates_default(true);
+    Gtk::Label result;
+    result.set_halign(Gtk::ALIGN_START);
+
+    // Evaluating touches at most the few bytes a read names, so it runs on every keystroke.
+    std::size_t offset = 0;
+    bool valid = false;
+    auto evaluate = [&] {
+        std::string error;
+        valid = OffsetExpr::evaluate(entry.get_text(), ctx, offset, error);
+        if (valid && offset == ctx.size) offset = ctx.size - 1;   // "end" lands on the last byte
+        if (valid && offset >= ctx.size) {
+            valid = false;
+            error = "past the end of the file";
+        }
+        std::ostringstream ss;
+        if (valid) ss << "= 0x" << std::hex << std::uppercase << offset << std::dec << " (" << offset << ")";
+        else if (!entry.get_text().empty()) ss << error;
+        result.set_text(ss.str());
+        dlg.set_response_sensitive(Gtk::RESPONSE_OK, valid);
+    };
+    entry.signal_changed().connect(evaluate);
+
+    box->pack_start(label, Gtk::PACK_SHRINK);
+    box->pack_start(entry, Gtk::PACK_SHRINK);
+    box->pack_start(result, Gtk::PACK_SHRINK);
+    dlg.set_default_response(Gtk::RESPONSE_OK);
+    dlg.show_all_children();
+    evaluate();
+
+    if (dlg.run() != Gtk::RESPONSE_OK || !valid) return;
+    m_last_goto = entry.get_text();
+
+    doc.view.scroll_to_byte(offset);
+    std::ostringstream ss;
+    ss << "Jumped to 0x" << std::hex << std::uppercase << offset;
+    status(ss.str());
+}
+
+void MainWindow::on_search_match_activated(std::size_t offset, std::size_t length) {
+    if (!m_active->view.select_bytes(offset, offset + length)) m_active->view.scroll_to_byte(offset);
+    std::ostringstream ss;
+    ss << "Match at 0x" << std::hex << std::uppercase << offset << std::dec << " (" << length << " bytes)";
+    status(ss.str());
+}
+
+void MainWindow::on_search_results_ready() {
+    // Hits arrive sorted; a million-hit result set is built into the tree in one pass.
+    const auto& hits = m_search_panel.hits();
+    std::vector<Mark> marks;
+    marks.reserve(hits.size());
+    for (std::size_t offset : hits)
+        marks.push_back({offset, offset + std::max<std::size_t>(1, m_search_panel.match_length(offset)),
+                         MarkKind::SearchHit, 0});
+    m_active->search_marks.assign(marks);
+    m_active->view.refresh_marks();
+}
+
+void MainWindow::on_search_add_bookmark() {
+    if (m_active->buffer.data.empty()) { status("Bookmark: load a file first."); return; }
+    const std::size_t offset = m_active->view.cursor_byte();
+
+    Gtk::Dialog dlg("Add Bookmark", *this);
+    dlg.add_button("Cancel", Gtk::RESPONSE_CANCEL);
+    dlg.add_button("Add", Gtk::RESPONSE_OK);
+
+    auto* box = dlg.get_content_area();
+    std::ostringstream prompt;
+    prompt << "Name for the bookmark at 0x" << std::hex << std::uppercase << offset << ":";
+    Gtk::Label label(prompt.str());
+    label.set_halign(Gtk::ALIGN_START);
+    Gtk::Entry entry;
+    entry.set_text("bm" + std::to_string(m_active->bookmark_names.size() + 1));
+    entry.set_activates_default(true);
+
+    box->pack_start(label, Gtk::PACK_SHRINK);
+    box->pack_start(entry, Gtk::PACK_SHRINK);
+    dlg.set_default_response(Gtk::RESPONSE_OK);
+    dlg.show_all_children();
+
+    if (dlg.run() != Gtk::RESPONSE_OK) return;
+
+    std::string name = entry.get_text();
+    name.erase(std::remove_if(name.begin(), name.end(), [](unsigned char c) { return std::isspace(c); }), name.end());
+    if (name.empty()) { status("Bookmark: a name is required."); return; }
+    std::string error;
+    if (!OffsetExpr::valid_name(name, error)) { status("Bookmark: " + error + "."); return; }
+
+    m_active->add_bookmark(offset, name);
+    status("Bookmark '" + name + "' added.");
+}
+
+void MainWindow::on_search_bookmark_step(bool forward) {
+    // Highlights share the tree, so step over them until a bookmark turns up.
+    std::size_t pos = m_active->view.cursor_byte();
+    Mark m{};
+    std::vector<Mark> at;
+    for (bool found = false; !found;) {
+        if (!(forward ? m_active->marks.next_after(pos, m) : m_active->marks.prev_before(pos, m))) {
+            status(forward ? "No bookmark after the cursor." : "No bookmark before the cursor.");
+            return;
+        }
+        // Several marks can start on the same byte; look at all of them before moving on.
+        at.clear();
+        m_active->marks.query(m.begin, m.begin + 1, at);
+        for (const Mark& c : at) {
+            if (c.begin == m.begin && c.kind == MarkKind::Bookmark) { m = c; found = true; break; }
+        }
+        pos = m.begin;
+    }
+    m_active->view.scroll_to_byte(m.begin);
+    const std::string& name = m.tag < m_active->bookmark_names.size() ? m_active->bookmark_names[m.tag] : "";
+    std::ostringstream ss;
+    ss << "Bookmark '" << name << "' at 0x" << std::hex << std::uppercase << m.begin;
+    status(ss.str());
+}
+
+void MainWindow::on_search_highlight_selection() {
+    std::size_t start = 0, end = 0;
+    if (!m_active->view.get_selected_byte_range(start, end)) { status("Highlight: no selection."); return; }
+    m_active->add_highlight(start, end, m_next_highlight++);
+    status("Selection highlighted.");
+}
+
+void MainWindow::on_search_clear_marks(MarkKind kind) {
+    m_active->clear_marks(kind);
+    status(kind == MarkKind::SearchHit ? "Search marks cleared." : "Highlights cleared.");
+}
+
 void MainWindow::on_analysis_frequency() { status("Analysis: hook up your existing frequency logic here."); }
 
+void MainWindow::on_analysis_entropy() {
+    if (m_active->buffer.data.empty()) { status("Entropy: load a file first."); return; }
+
+    const auto& blocks = m_active->cache.block_entropy(m_active->buffer.data.data(), m_active->buffer.data.size());
+    double sum = 0.0;
+    float peak = 0.0f;
+    std::size_t peak_block = 0;
+    for (std::size_t b = 0; b < blocks.size(); ++b) {
+        sum += blocks[b];
+        if (blocks[b] > peak) { peak = blocks[b]; peak_block = b; }
+    }
+
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(3)
+       << "Entropy: mean " << (blocks.empty() ? 0.0 : sum / static_cast<double>(blocks.size()))
+       << " bits/byte, max " << peak << " at 0x" << std::hex << std::uppercase
+       << peak_block * AnalysisCache::kBlockSize;
+    status(ss.str());
+}
+
+void MainWindow::on_analysis_strings() {
+    show_side_panel(m_strings_panel);
+    if (m_active->buffer.data.empty()) { status("Strings: load a file first."); return; }
+    m_strings_panel.start_scan();
+    status("Scanning for strings...");
+}
+
+void MainWindow::on_string_activated(std::size_t offset) {
+    m_active->view.scroll_to_byte(offset);
+    std::ostringstream ss;
+    ss << "String at 0x" << std::hex << std::uppercase << offset;
+    status(ss.str());
+}
+
+void MainWindow::on_analysis_template() {
+    show_side_panel(m_template_panel);
+    status("Template: load a definition, then apply it at the cursor.");
+}
+
+void MainWindow::on_template_apply_requested() {
+    if (m_active->buffer.data.empty()) { status("Template: load a file first."); return; }
+    const std::size_t base = m_active->view.cursor_byte();
+    m_template_panel.apply_at(base);
+    std::ostringstream ss;
+    ss << "Template applied at 0x" << std::hex << std::uppercase << base;
+    status(ss.str());
+}
+
+void MainWindow::on_template_changed() {
+    if (!m_active) return;
+    m_active->view.set_template(m_template_panel.active_template(), m_template_panel.base());
+}
+
+void MainWindow::on_template_field_activated(std::size_t offset) {
+    m_active->view.scroll_to_byte(offset);
+}
+
 void MainWindow::on_help_about() {
     Gtk::AboutDialog dlg;
     dlg.set_transient_for(*this);
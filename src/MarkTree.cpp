@@ -0,0 +1,274 @@
+#include "MarkTree.hpp"
+#include <algorithm>
+
+MarkTree::MarkTree() {
+    m_nodes.push_back(Node{});
+}
+
+std::uint32_t MarkTree::random() {
+    // xorshift32; priorities only need to be unpredictable relative to the keys.
+    m_seed ^= m_seed << 13;
+    m_seed ^= m_seed >> 17;
+    m_seed ^= m_seed << 5;
+    return m_seed;
+}
+
+std::uint32_t MarkTree::alloc(const Mark& mark) {
+    const Node node{mark, mark.end, 0, 0, 0, random()};
+    std::uint32_t n;
+    if (!m_free.empty()) {
+        n = m_free.back();
+        m_free.pop_back();
+        m_nodes[n] = node;
+    } else {
+        n = static_cast<std::uint32_t>(m_nodes.size());
+        m_nodes.push_back(node);
+    }
+    ++m_size;
+    return n;
+}
+
+void MarkTree::release(std::uint32_t n) {
+    m_free.push_back(n);
+    --m_size;
+}
+
+void MarkTree::clear() {
+    m_nodes.resize(1);
+    m_nodes.shrink_to_fit();
+    m_free.clear();
+    m_free.shrink_to_fit();
+    m_root = 0;
+    m_size = 0;
+}
+
+void MarkTree::push(std::uint32_t n) {
+    Node& node = m_nodes[n];
+    if (node.shift == 0) return;
+    node.mark.begin += node.shift;
+    node.mark.end += node.shift;
+    node.max_end += node.shift;
+    if (node.left) m_nodes[node.left].shift += node.shift;
+    if (node.right) m_nodes[node.right].shift += node.shift;
+    node.shift = 0;
+}
+
+void MarkTree::pull(std::uint32_t n) {
+    Node& node = m_nodes[n];
+    node.max_end = node.mark.end;
+    if (node.left) node.max_end = std::max(node.max_end, m_nodes[node.left].max_end + m_nodes[node.left].shift);
+    if (node.right) node.max_end = std::max(node.max_end, m_nodes[node.right].max_end + m_nodes[node.right].shift);
+}
+
+void MarkTree::split(std::uint32_t t, std::size_t key, std::uint32_t& left, std::uint32_t& right) {
+    if (!t) {
+        left = right = 0;
+        return;
+    }
+    push(t);
+    if (m_nodes[t].mark.begin < key) {
+        split(m_nodes[t].right, key, m_nodes[t].right, right);
+        left = t;
+    } else {
+        split(m_nodes[t].left, key, left, m_nodes[t].left);
+        right = t;
+    }
+    pull(t);
+}
+
+std::uint32_t MarkTree::merge(std::uint32_t a, std::uint32_t b) {
+    if (!a) return b;
+    if (!b) return a;
+    if (m_nodes[a].priority > m_nodes[b].priority) {
+        push(a);
+        m_nodes[a].right = merge(m_nodes[a].right, b);
+        pull(a);
+        return a;
+    }
+    push(b);
+    m_nodes[b].left = merge(a, m_nodes[b].left);
+    pull(b);
+    return b;
+}
+
+void MarkTree::take_all(std::uint32_t t, std::vector<Mark>& out) {
+    if (!t) return;
+    push(t);
+    take_all(m_nodes[t].left, out);
+    out.push_back(m_nodes[t].mark);
+    take_all(m_nodes[t].right, out);
+    release(t);
+}
+
+void MarkTree::insert(const Mark& mark) {
+    const std::uint32_t n = alloc(mark);
+    std::uint32_t left = 0, right = 0;
+    split(m_root, mark.begin, left, right);
+    m_root = merge(merge(left, n), right);
+}
+
+bool MarkTree::erase(const Mark& mark) {
+    std::uint32_t left = 0, rest = 0, same = 0, right = 0;
+    split(m_root, mark.begin, left, rest);
+    split(rest, mark.begin + 1, same, right);
+
+    std::vector<Mark> at_begin;
+    take_all(same, at_begin);
+    bool found = false;
+    same = 0;
+    for (const Mark& m : at_begin) {
+        if (!found && m.end == mark.end && m.kind == mark.kind && m.tag == mark.tag) {
+            found = true;
+            continue;
+        }
+        same = merge(same, alloc(m));
+    }
+    m_root = merge(merge(left, same), right);
+    return found;
+}
+
+void MarkTree::assign(const std::vector<Mark>& marks) {
+    clear();
+    m_nodes.reserve(marks.size() + 1);
+
+    // Cartesian tree over the sorted marks: the stack holds the right spine.
+    std::vector<std::uint32_t> spine;
+    for (const Mark& mark : marks) {
+        const std::uint32_t n = alloc(mark);
+        std::uint32_t last = 0;
+        while (!spine.empty() && m_nodes[spine.back()].priority < m_nodes[n].priority) {
+            last = spine.back();
+            spine.pop_back();
+        }
+        m_nodes[n].left = last;
+        if (!spine.empty()) m_nodes[spine.back()].right = n;
+        spine.push_back(n);
+    }
+    m_root = spine.empty() ? 0 : spine.front();
+
+    // max_end bottom-up; children always come after their parent in this order.
+    std::vector<std::uint32_t> order;
+    order.reserve(m_size);
+    if (m_root) order.push_back(m_root);
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        if (m_nodes[order[i]].left) order.push_back(m_nodes[order[i]].left);
+        if (m_nodes[order[i]].right) order.push_back(m_nodes[order[i]].right);
+    }
+    for (auto it = order.rbegin(); it != order.rend(); ++it) pull(*it);
+}
+
+void MarkTree::grow(std::uint32_t t, std::size_t at, std::size_t len) {
+    if (!t || m_nodes[t].max_end + m_nodes[t].shift <= at) return;
+    push(t);
+    if (m_nodes[t].mark.end > at) m_nodes[t].mark.end += len;
+    grow(m_nodes[t].left, at, len);
+    grow(m_nodes[t].right, at, len);
+    pull(t);
+}
+
+void MarkTree::clip(std::uint32_t t, std::size_t at, std::size_t len) {
+    if (!t || m_nodes[t].max_end + m_nodes[t].shift <= at) return;
+    push(t);
+    std::size_t& end = m_nodes[t].mark.end;
+    if (end > at) end = end <= at + len ? at : end - len;
+    clip(m_nodes[t].left, at, len);
+    clip(m_nodes[t].right, at, len);
+    pull(t);
+}
+
+void MarkTree::on_insert(std::size_t at, std::size_t len) {
+    if (len == 0 || !m_root) return;
+    std::uint32_t left = 0, right = 0;
+    split(m_root, at, left, right);
+    if (right) m_nodes[right].shift += len;
+    grow(left, at, len);   // every mark in `left` begins before `at`
+    m_root = merge(left, right);
+}
+
+void MarkTree::on_erase(std::size_t at, std::size_t len) {
+    if (len == 0 || !m_root) return;
+    std::uint32_t left = 0, rest = 0, inside = 0, right = 0;
+    split(m_root, at, left, rest);
+    split(rest, at + len, inside, right);
+
+    std::vector<Mark> started_inside;
+    take_all(inside, started_inside);
+    if (right) m_nodes[right].shift -= len;
+    clip(left, at, len);
+
+    // Marks that began in the deleted range keep whatever extends past it.
+    m_root = left;
+    for (Mark m : started_inside) {
+        if (m.end <= at + len) continue;
+        m.begin = at;
+        m.end -= len;
+        m_root = merge(m_root, alloc(m));
+    }
+    m_root = merge(m_root, right);
+}
+
+void MarkTree::query(std::size_t begin, std::size_t end, std::vector<Mark>& out) const {
+    if (begin < end) query(m_root, 0, begin, end, out);
+}
+
+void MarkTree::query(std::uint32_t t, std::size_t shift, std::size_t begin, std::size_t end,
+                     std::vector<Mark>& out) const {
+    if (!t) return;
+    const Node& node = m_nodes[t];
+    shift += node.shift;
+    if (node.max_end + shift <= begin) return;
+
+    query(node.left, shift, begin, end, out);
+    const std::size_t b = node.mark.begin + shift;
+    if (b >= end) return;   // everything to the right begins later still
+    if (node.mark.end + shift > begin) out.push_back({b, node.mark.end + shift, node.mark.kind, node.mark.tag});
+    query(node.right, shift, begin, end, out);
+}
+
+bool MarkTree::next_after(std::size_t pos, Mark& out) const {
+    bool found = false;
+    std::size_t shift = 0;
+    for (std::uint32_t t = m_root; t;) {
+        const Node& node = m_nodes[t];
+        shift += node.shift;
+        if (node.mark.begin + shift > pos) {
+            out = {node.mark.begin + shift, node.mark.end + shift, node.mark.kind, node.mark.tag};
+            found = true;
+            t = node.left;
+        } else {
+            t = node.right;
+        }
+    }
+    return found;
+}
+
+bool MarkTree::prev_before(std::size_t pos, Mark& out) const {
+    bool found = false;
+    std::size_t shift = 0;
+    for (std::uint32_t t = m_root; t;) {
+        const Node& node = m_nodes[t];
+        shift += node.shift;
+        if (node.mark.begin + shift < pos) {
+            out = {node.mark.begin + shift, node.mark.end + shift, node.mark.kind, node.mark.tag};
+            found = true;
+            t = node.right;
+        } else {
+            t = node.left;
+        }
+    }
+    return found;
+}
+
+void MarkTree::collect(std::vector<Mark>& out) const {
+    out.reserve(out.size() + m_size);
+    collect(m_root, 0, out);
+}
+
+void MarkTree::collect(std::uint32_t t, std::size_t shift, std::vector<Mark>& out) const {
+    if (!t) return;
+    const Node& node = m_nodes[t];
+    shift += node.shift;
+    collect(node.left, shift, out);
+    out.push_back({node.mark.begin + shift, node.mark.end + shift, node.mark.kind, node.mark.tag});
+    collect(node.right, shift, out);
+}
@@ -0,0 +1,63 @@
+#include "MemoryBudget.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+#include <unistd.h>
+
+MemoryBudget& MemoryBudget::shared() {
+    static MemoryBudget budget;
+    return budget;
+}
+
+MemoryBudget::MemoryBudget() {
+    if (const char* env = std::getenv("HEXEDITPRO_MEMORY_MB")) {
+        const unsigned long long mb = std::strtoull(env, nullptr, 10);
+        if (mb > 0) {
+            m_limit = static_cast<std::size_t>(mb) << 20;
+            return;
+        }
+    }
+
+    const long pages = sysconf(_SC_PHYS_PAGES);
+    const long page_size = sysconf(_SC_PAGE_SIZE);
+    const std::size_t physical = (pages > 0 && page_size > 0)
+                                     ? static_cast<std::size_t>(pages) * static_cast<std::size_t>(page_size)
+                                     : std::size_t{4} << 30;
+    m_limit = std::min(physical / 4, std::size_t{4} << 30);
+}
+
+MemoryBudget::Id MemoryBudget::add(SizeFn resident, ReleaseFn release) {
+    const Id id = m_next_id++;
+    m_lru.push_back({id, std::move(resident), std::move(release)});
+    return id;
+}
+
+void MemoryBudget::remove(Id id) {
+    m_lru.remove_if([id](const Holder& h) { return h.id == id; });
+}
+
+void MemoryBudget::touch(Id id) {
+    auto it = std::find_if(m_lru.begin(), m_lru.end(), [id](const Holder& h) { return h.id == id; });
+    if (it != m_lru.end()) m_lru.splice(m_lru.end(), m_lru, it);
+}
+
+std::size_t MemoryBudget::resident() const {
+    std::size_t total = 0;
+    for (const auto& h : m_lru) total += h.resident();
+    return total;
+}
+
+std::size_t MemoryBudget::enforce(Id keep) {
+    std::size_t total = resident();
+    std::size_t freed = 0;
+    for (auto& h : m_lru) {
+        if (total <= m_limit) break;
+        if (h.id == keep) continue;
+        const std::size_t before = h.resident();
+        if (before == 0 || !h.release()) continue;
+        const std::size_t released = before - std::min(before, h.resident());
+        total -= released;
+        freed += released;
+    }
+    return freed;
+}
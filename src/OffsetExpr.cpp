@@ -0,0 +1,241 @@
+#include "OffsetExpr.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+
+namespace {
+
+using Value = std::int64_t;
+
+// u8 u16 u32 u64 with an optional le/be suffix.
+bool is_read(const std::string& id, std::size_t& width, bool& big) {
+    std::string base = id;
+    big = false;
+    if (base.size() > 2 && (base.compare(base.size() - 2, 2, "le") == 0 || base.compare(base.size() - 2, 2, "be") == 0)) {
+        big = base[base.size() - 2] == 'b';
+        base.resize(base.size() - 2);
+    }
+    if (base == "u8") width = 1;
+    else if (base == "u16") width = 2;
+    else if (base == "u32") width = 4;
+    else if (base == "u64") width = 8;
+    else return false;
+    return true;
+}
+
+class Parser {
+public:
+    Parser(const std::string& text, const OffsetContext& ctx, std::string& error)
+        : m_text(text), m_ctx(ctx), m_error(error) {}
+
+    bool parse(Value& out) {
+        skip_space();
+        // "+0x40" / "-0x40" step from the cursor; the sign binds to the first term
+        // only, so "-0x10+4" is cursor-0x10+4.
+        const char lead = peek();
+        if (lead == '+' || lead == '-') {
+            ++m_pos;
+            Value step = 0;
+            if (!product(step)) return false;
+            if (!combine(static_cast<Value>(m_ctx.cursor), lead, step, out)) return false;
+            if (!sum_rest(out)) return false;
+        } else if (!sum(out)) {
+            return false;
+        }
+        skip_space();
+        if (m_pos != m_text.size()) return fail("unexpected '" + std::string(1, m_text[m_pos]) + "'");
+        return true;
+    }
+
+private:
+    const std::string& m_text;
+    const OffsetContext& m_ctx;
+    std::string& m_error;
+    std::size_t m_pos{0};
+
+    char peek() const { return m_pos < m_text.size() ? m_text[m_pos] : '\0'; }
+
+    void skip_space() {
+        while (m_pos < m_text.size() && std::isspace(static_cast<unsigned char>(m_text[m_pos]))) ++m_pos;
+    }
+
+    bool fail(const std::string& msg) {
+        if (m_error.empty()) m_error = msg;
+        return false;
+    }
+
+    bool combine(Value a, char op, Value b, Value& out) {
+        bool overflow = false;
+        switch (op) {
+            case '+': overflow = __builtin_add_overflow(a, b, &out); break;
+            case '-': overflow = __builtin_sub_overflow(a, b, &out); break;
+            case '*': overflow = __builtin_mul_overflow(a, b, &out); break;
+            default:
+                if (b == 0) return fail("division by zero");
+                if (a == INT64_MIN && b == -1) return fail("value out of range");
+                out = a / b;
+                break;
+        }
+        return overflow ? fail("value out of range") : true;
+    }
+
+    bool sum(Value& out) {
+        return product(out) && sum_rest(out);
+    }
+
+    // Folds any further "+ term" / "- term" into `out`.
+    bool sum_rest(Value& out) {
+        for (;;) {
+            skip_space();
+            const char op = peek();
+            if (op != '+' && op != '-') return true;
+            ++m_pos;
+            Value rhs = 0;
+            if (!product(rhs) || !combine(out, op, rhs, out)) return false;
+        }
+    }
+
+    bool product(Value& out) {
+        if (!unary(out)) return false;
+        for (;;) {
+            skip_space();
+            const char op = peek();
+            if (op != '*' && op != '/') return true;
+            ++m_pos;
+            Value rhs = 0;
+            if (!unary(rhs) || !combine(out, op, rhs, out)) return false;
+        }
+    }
+
+    bool unary(Value& out) {
+        skip_space();
+        if (peek() == '-') {
+            ++m_pos;
+            Value v = 0;
+            return unary(v) && combine(0, '-', v, out);
+        }
+        return primary(out);
+    }
+
+    bool primary(Value& out) {
+        skip_space();
+        const char c = peek();
+        if (c == '(') {
+            ++m_pos;
+            if (!sum(out)) return false;
+            skip_space();
+            if (peek() != ')') return fail("missing ')'");
+            ++m_pos;
+            return true;
+        }
+        if (std::isdigit(static_cast<unsigned char>(c))) return number(out);
+        if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') return name(out);
+        return fail(c ? "unexpected '" + std::string(1, c) + "'" : "expression ends early");
+    }
+
+    bool number(Value& out) {
+        // Digits and letters run together ("1F00h", "0x1f"), then the form is decided.
+        const std::size_t start = m_pos;
+        while (m_pos < m_text.size() && std::isalnum(static_cast<unsigned char>(m_text[m_pos]))) ++m_pos;
+        std::string tok = m_text.substr(start, m_pos - start);
+
+        unsigned base = 10;
+        if (tok.size() > 2 && tok[0] == '0' && (tok[1] == 'x' || tok[1] == 'X')) {
+            tok.erase(0, 2);
+            base = 16;
+        } else if (tok.size() > 1 && (tok.back() == 'h' || tok.back() == 'H')) {
+            tok.pop_back();
+            base = 16;
+        }
+
+        std::uint64_t v = 0;
+        for (char ch : tok) {
+            const unsigned char u = static_cast<unsigned char>(ch);
+            unsigned d = 0;
+            if (std::isdigit(u)) d = static_cast<unsigned>(u - '0');
+            else if (base == 16 && std::isxdigit(u)) d = static_cast<unsigned>(std::tolower(u) - 'a' + 10);
+            else return fail("bad number '" + m_text.substr(start, m_pos - start) + "'");
+            if (d >= base) return fail("bad number '" + m_text.substr(start, m_pos - start) + "'");
+            if (v > (static_cast<std::uint64_t>(INT64_MAX) - d) / base) return fail("value out of range");
+            v = v * base + d;
+        }
+        out = static_cast<Value>(v);
+        return true;
+    }
+
+    bool name(Value& out) {
+        const std::size_t start = m_pos;
+        while (m_pos < m_text.size() &&
+               (std::isalnum(static_cast<unsigned char>(m_text[m_pos])) || m_text[m_pos] == '_'))
+            ++m_pos;
+        const std::string id = m_text.substr(start, m_pos - start);
+
+        std::size_t width = 0;
+        bool big = false;
+        if (is_read(id, width, big)) return read(width, big, out);
+        if (id == "end") { out = static_cast<Value>(m_ctx.size); return true; }
+        if (id == "cursor") { out = static_cast<Value>(m_ctx.cursor); return true; }
+
+        std::size_t offset = 0;
+        if (m_ctx.lookup && m_ctx.lookup(id, offset)) {
+            out = static_cast<Value>(offset);
+            return true;
+        }
+        return fail("unknown name '" + id + "' (hex numbers need 0x or an h suffix)");
+    }
+
+    bool read(std::size_t width, bool big, Value& out) {
+        Value at = static_cast<Value>(m_ctx.cursor);
+        skip_space();
+        if (peek() == '(') {
+            ++m_pos;
+            if (!sum(at)) return false;
+            skip_space();
+            if (peek() != ')') return fail("missing ')'");
+            ++m_pos;
+        }
+        if (at < 0 || !m_ctx.data || static_cast<std::size_t>(at) > m_ctx.size ||
+            m_ctx.size - static_cast<std::size_t>(at) < width)
+            return fail("read past the end of the file");
+
+        const unsigned char* p = m_ctx.data + at;
+        std::uint64_t v = 0;
+        for (std::size_t i = 0; i < width; ++i)
+            v |= static_cast<std::uint64_t>(p[big ? width - 1 - i : i]) << (8 * i);
+        if (v > static_cast<std::uint64_t>(INT64_MAX)) return fail("value out of range");
+        out = static_cast<Value>(v);
+        return true;
+    }
+};
+
+} // namespace
+
+bool OffsetExpr::valid_name(const std::string& name, std::string& error) {
+    error.clear();
+    const auto ident = [](char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_'; };
+    if (name.empty() || std::isdigit(static_cast<unsigned char>(name[0])) ||
+        !std::all_of(name.begin(), name.end(), ident)) {
+        error = "use letters, digits and '_', not starting with a digit";
+        return false;
+    }
+    std::size_t width = 0;
+    bool big = false;
+    if (name == "end" || name == "cursor" || is_read(name, width, big)) {
+        error = "'" + name + "' is a built-in name";
+        return false;
+    }
+    return true;
+}
+
+bool OffsetExpr::evaluate(const std::string& text, const OffsetContext& ctx, std::size_t& out, std::string& error) {
+    error.clear();
+    Value v = 0;
+    Parser parser(text, ctx, error);
+    if (!parser.parse(v)) return false;
+    if (v < 0) {
+        error = "negative offset";
+        return false;
+    }
+    out = static_cast<std::size_t>(v);
+    return true;
+}
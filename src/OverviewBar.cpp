@@ -0,0 +1,107 @@
+#include "OverviewBar.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace {
+constexpr int kWidth = 28;
+}
+
+OverviewBar::OverviewBar() {
+    set_size_request(kWidth, -1);
+    add_events(Gdk::BUTTON_PRESS_MASK | Gdk::BUTTON1_MOTION_MASK);
+    signal_draw().connect(sigc::mem_fun(*this, &OverviewBar::on_bar_draw));
+    signal_button_press_event().connect(sigc::mem_fun(*this, &OverviewBar::on_bar_button_press));
+    signal_motion_notify_event().connect(sigc::mem_fun(*this, &OverviewBar::on_bar_motion));
+}
+
+void OverviewBar::set_source(ClassSource source) {
+    m_source = std::move(source);
+    queue_draw();
+}
+
+void OverviewBar::set_file_size(std::size_t size) {
+    if (size == m_size) return;
+    m_size = size;
+    queue_draw();
+}
+
+void OverviewBar::set_viewport(std::size_t begin, std::size_t end) {
+    if (begin == m_view_begin && end == m_view_end) return;
+    m_view_begin = begin;
+    m_view_end = end;
+    queue_draw();
+}
+
+std::size_t OverviewBar::offset_at(double y) const {
+    const double h = std::max(1, get_allocated_height());
+    const double t = std::clamp(y / h, 0.0, 1.0);
+    return std::min(m_size - 1, static_cast<std::size_t>(t * static_cast<double>(m_size)));
+}
+
+bool OverviewBar::on_bar_draw(const Cairo::RefPtr<Cairo::Context>& cr) {
+    const int width = get_allocated_width();
+    const int height = get_allocated_height();
+    cr->set_source_rgba(0.5, 0.5, 0.5, 0.12);
+    cr->paint();
+    if (m_size == 0 || !m_source || height <= 0) return true;
+
+    const auto& classes = m_source();
+    const std::size_t B = AnalysisCache::kBlockSize;
+    const std::size_t nblocks = classes.size();
+
+    // zero, text, control, high
+    static const double kColors[4][3] = {
+        {0.35, 0.35, 0.38}, {0.26, 0.55, 0.90}, {0.95, 0.62, 0.20}, {0.85, 0.28, 0.35},
+    };
+
+    for (int y = 0; y < height && nblocks; ++y) {
+        const std::size_t lo = static_cast<std::size_t>(static_cast<double>(m_size) * y / height);
+        const std::size_t hi = static_cast<std::size_t>(static_cast<double>(m_size) * (y + 1) / height);
+        const std::size_t b0 = std::min(nblocks - 1, lo / B);
+        const std::size_t b1 = std::min(nblocks, std::max(b0 + 1, (hi + B - 1) / B));
+
+        unsigned long sums[4] = {};
+        for (std::size_t b = b0; b < b1; ++b) {
+            sums[0] += classes[b].zero;
+            sums[1] += classes[b].text;
+            sums[2] += classes[b].control;
+            sums[3] += classes[b].high;
+        }
+        const double total = static_cast<double>(sums[0] + sums[1] + sums[2] + sums[3]);
+        if (total <= 0) continue;
+
+        double x = 0;
+        for (int c = 0; c < 4; ++c) {
+            const double w = width * static_cast<double>(sums[c]) / total;
+            if (w <= 0) continue;
+            cr->set_source_rgb(kColors[c][0], kColors[c][1], kColors[c][2]);
+            cr->rectangle(x, y, w, 1);
+            cr->fill();
+            x += w;
+        }
+    }
+
+    if (m_view_end > m_view_begin) {
+        const double y0 = static_cast<double>(m_view_begin) / static_cast<double>(m_size) * height;
+        const double y1 = static_cast<double>(m_view_end) / static_cast<double>(m_size) * height;
+        cr->set_source_rgba(1.0, 1.0, 1.0, 0.25);
+        cr->rectangle(0, y0, width, std::max(2.0, y1 - y0));
+        cr->fill_preserve();
+        cr->set_source_rgba(0.0, 0.0, 0.0, 0.7);
+        cr->set_line_width(1.0);
+        cr->stroke();
+    }
+    return true;
+}
+
+bool OverviewBar::on_bar_button_press(GdkEventButton* ev) {
+    if (ev->button != 1 || m_size == 0) return false;
+    m_signal_jump.emit(offset_at(ev->y));
+    return true;
+}
+
+bool OverviewBar::on_bar_motion(GdkEventMotion* ev) {
+    if (!(ev->state & GDK_BUTTON1_MASK) || m_size == 0) return false;
+    m_signal_jump.emit(offset_at(ev->y));
+    return true;
+}
@@ -0,0 +1,265 @@
+#include "SearchPanel.hpp"
+#include "StringScanner.hpp"
+#include "WorkerPool.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+namespace {
+constexpr std::size_t kMaxPreviewChars = 160;
+}
+
+SearchPanel::SearchPanel()
+    : Gtk::Box(Gtk::ORIENTATION_VERTICAL),
+      m_vadj(Gtk::Adjustment::create(0, 0, 0, 1, 10, 10)),
+      m_vscroll(m_vadj, Gtk::ORIENTATION_VERTICAL) {
+    m_query.set_placeholder_text("Text or regular expression");
+    m_encoding.append("ASCII");
+    m_encoding.append("UTF-16LE");
+    m_encoding.append("UTF-16BE");
+    m_encoding.set_active(0);
+
+    m_query_row.set_spacing(6);
+    m_query_row.pack_start(m_query, Gtk::PACK_EXPAND_WIDGET);
+    m_query_row.pack_end(m_find_button, Gtk::PACK_SHRINK);
+
+    m_options_row.set_spacing(6);
+    m_options_row.pack_start(m_regex, Gtk::PACK_SHRINK);
+    m_options_row.pack_start(m_ignore_case, Gtk::PACK_SHRINK);
+    m_options_row.pack_end(m_encoding, Gtk::PACK_SHRINK);
+
+    m_summary.set_halign(Gtk::ALIGN_START);
+    m_summary.set_line_wrap(true);
+
+    m_list.add_events(Gdk::SCROLL_MASK | Gdk::SMOOTH_SCROLL_MASK | Gdk::BUTTON_PRESS_MASK);
+    m_list_box.pack_start(m_list, Gtk::PACK_EXPAND_WIDGET);
+    m_list_box.pack_start(m_vscroll, Gtk::PACK_SHRINK);
+
+    set_spacing(4);
+    pack_start(m_query_row, Gtk::PACK_SHRINK);
+    pack_start(m_options_row, Gtk::PACK_SHRINK);
+    pack_start(m_summary, Gtk::PACK_SHRINK);
+    pack_start(m_list_box, Gtk::PACK_EXPAND_WIDGET);
+
+    m_find_button.signal_clicked().connect(sigc::mem_fun(*this, &SearchPanel::start_search));
+    m_query.signal_activate().connect(sigc::mem_fun(*this, &SearchPanel::start_search));
+    m_dispatcher.connect(sigc::mem_fun(*this, &SearchPanel::on_dispatch));
+    m_vadj->signal_value_changed().connect([this] { m_list.queue_draw(); });
+    m_list.signal_draw().connect(sigc::mem_fun(*this, &SearchPanel::on_list_draw));
+    m_list.signal_scroll_event().connect(sigc::mem_fun(*this, &SearchPanel::on_list_scroll));
+    m_list.signal_button_press_event().connect(sigc::mem_fun(*this, &SearchPanel::on_list_button_press));
+    m_list.signal_size_allocate().connect(sigc::mem_fun(*this, &SearchPanel::on_list_size_allocate));
+
+    update_summary();
+    show_all_children();
+}
+
+SearchPanel::~SearchPanel() {
+    invalidate();
+}
+
+void SearchPanel::set_buffer(const HexBuffer* buffer) {
+    invalidate();
+    m_buffer = buffer;
+}
+
+void SearchPanel::focus_query() {
+    m_query.grab_focus();
+}
+
+void SearchPanel::invalidate() {
+    m_cancel = true;
+    if (m_job.valid()) m_job.wait();
+    m_cancel = false;
+
+    {
+        std::lock_guard<std::mutex> lock(m_pending_mutex);
+        m_pending.clear();
+        m_search_done = false;
+    }
+    m_searching = false;
+    m_from_cache = false;
+    m_error.clear();
+    m_hits.clear();
+    m_hits.shrink_to_fit();
+    m_selected = static_cast<std::size_t>(-1);
+    m_vadj->set_value(0);
+    update_range();
+    update_summary();
+    m_list.queue_draw();
+}
+
+void SearchPanel::start_search() {
+    invalidate();
+    if (!m_buffer || m_buffer->data.empty() || m_query.get_text().empty()) return;
+
+    TextSearchOptions opts;
+    opts.regex = m_regex.get_active();
+    opts.ignore_case = m_ignore_case.get_active();
+    opts.encoding = static_cast<TextEncoding>(std::max(0, m_encoding.get_active_row_number()));
+
+    if (!m_search.compile(m_query.get_text(), opts, m_error)) {
+        update_summary();
+        return;
+    }
+
+    const unsigned char* data = m_buffer->data.data();
+    const std::size_t n = m_buffer->data.size();
+
+    if (m_cache && m_cache->text_search_hits(data, n, m_search, m_hits)) {
+        m_from_cache = true;
+        update_range();
+        update_summary();
+        m_list.queue_draw();
+        m_signal_results_ready.emit();
+        return;
+    }
+
+    m_searching = true;
+    update_summary();
+
+    m_job = WorkerPool::shared().submit([this, data, n] {
+        m_search.find(data, n, [this](std::vector<std::size_t>&& batch) {
+            if (batch.empty()) return;
+            {
+                std::lock_guard<std::mutex> lock(m_pending_mutex);
+                m_pending.insert(m_pending.end(), batch.begin(), batch.end());
+            }
+            m_dispatcher.emit();
+        }, &m_cancel);
+
+        {
+            std::lock_guard<std::mutex> lock(m_pending_mutex);
+            m_search_done = true;
+        }
+        m_dispatcher.emit();
+    });
+}
+
+void SearchPanel::on_dispatch() {
+    bool done = false;
+    {
+        std::lock_guard<std::mutex> lock(m_pending_mutex);
+        m_hits.insert(m_hits.end(), m_pending.begin(), m_pending.end());
+        m_pending.clear();
+        done = m_search_done;
+        m_search_done = false;
+    }
+
+    const bool finished = done && m_searching;
+    if (finished) {
+        if (m_job.valid()) m_job.get();
+        m_searching = false;
+        if (m_cache) m_cache->store_text_search_hits(m_search, m_hits);
+    }
+    update_range();
+    update_summary();
+    m_list.queue_draw();
+    if (finished) m_signal_results_ready.emit();
+}
+
+std::size_t SearchPanel::match_length(std::size_t offset) const {
+    if (!m_buffer || !m_search.valid()) return 0;
+    return m_search.match_at(m_buffer->data.data(), m_buffer->data.size(), offset);
+}
+
+void SearchPanel::update_range() {
+    const int h = std::max(1, m_list.get_allocated_height());
+    const double page = static_cast<double>(std::max(1, h / std::max(1, m_row_height)));
+    m_vadj->configure(std::min(m_vadj->get_value(), static_cast<double>(m_hits.size())),
+                      0, static_cast<double>(m_hits.size()), 1, page, page);
+}
+
+void SearchPanel::update_summary() {
+    if (!m_error.empty()) {
+        m_summary.set_text("Pattern error: " + m_error);
+        return;
+    }
+    char text[96];
+    std::snprintf(text, sizeof(text), "%zu matches%s", m_hits.size(),
+                  m_searching ? " (searching...)" : m_from_cache ? " (cached)" : "");
+    m_summary.set_text(text);
+}
+
+void SearchPanel::on_list_size_allocate(Gtk::Allocation&) {
+    update_range();
+}
+
+bool SearchPanel::on_list_draw(const Cairo::RefPtr<Cairo::Context>& cr) {
+    auto layout = m_list.create_pango_layout("0");
+    layout->set_font_description(Pango::FontDescription("Monospace 10"));
+    int w = 0, h = 0;
+    layout->get_pixel_size(w, h);
+    if (h > 0 && h != m_row_height) {
+        m_row_height = h;
+        update_range();
+    }
+
+    const int height = m_list.get_allocated_height();
+    const int width = m_list.get_allocated_width();
+    const std::size_t first = static_cast<std::size_t>(m_vadj->get_value());
+    const std::size_t rows = static_cast<std::size_t>(height / m_row_height + 1);
+    const auto fg = m_list.get_style_context()->get_color(Gtk::STATE_FLAG_NORMAL);
+
+    const unsigned char* data = m_buffer ? m_buffer->data.data() : nullptr;
+    const std::size_t size = m_buffer ? m_buffer->data.size() : 0;
+    const bool utf16 = m_search.options().encoding != TextEncoding::Ascii;
+
+    std::string line;
+    line.reserve(kMaxPreviewChars + 32);
+
+    for (std::size_t r = 0; r < rows && first + r < m_hits.size(); ++r) {
+        const std::size_t idx = first + r;
+        const std::size_t offset = m_hits[idx];
+        const int y = static_cast<int>(r) * m_row_height;
+
+        if (idx == m_selected) {
+            cr->set_source_rgba(0.25, 0.45, 0.85, 0.35);
+            cr->rectangle(0, y, width, m_row_height);
+            cr->fill();
+        }
+
+        char head[24];
+        std::snprintf(head, sizeof(head), "%010zX  ", offset);
+        line.assign(head);
+
+        const std::size_t len = data ? m_search.match_at(data, size, offset) : 0;
+        std::size_t shown = 0;
+        for (std::size_t i = offset; i < offset + len && shown < kMaxPreviewChars; ++i) {
+            const unsigned char c = data[i];
+            if (utf16 && c == 0) continue;   // high byte of a code unit
+            line.push_back(StringScanner::is_printable(c) && c != '\t' ? static_cast<char>(c) : '.');
+            ++shown;
+        }
+
+        layout->set_text(line);
+        cr->set_source_rgba(fg.get_red(), fg.get_green(), fg.get_blue(), fg.get_alpha());
+        cr->move_to(4, y);
+        layout->show_in_cairo_context(cr);
+    }
+    return true;
+}
+
+bool SearchPanel::on_list_scroll(GdkEventScroll* ev) {
+    double delta = 0;
+    if (ev->direction == GDK_SCROLL_UP) delta = -3;
+    else if (ev->direction == GDK_SCROLL_DOWN) delta = 3;
+    else if (ev->direction == GDK_SCROLL_SMOOTH) delta = ev->delta_y * 3;
+
+    const double upper = std::max(0.0, m_vadj->get_upper() - m_vadj->get_page_size());
+    m_vadj->set_value(std::clamp(m_vadj->get_value() + delta, 0.0, upper));
+    return true;
+}
+
+bool SearchPanel::on_list_button_press(GdkEventButton* ev) {
+    if (ev->button != 1 || !m_buffer) return false;
+    const std::size_t idx = static_cast<std::size_t>(m_vadj->get_value()) +
+                            static_cast<std::size_t>(std::max(0.0, ev->y) / m_row_height);
+    if (idx >= m_hits.size()) return false;
+
+    m_selected = idx;
+    m_list.queue_draw();
+    const std::size_t offset = m_hits[idx];
+    m_signal_match_activated.emit(offset, match_length(offset));
+    return true;
+}
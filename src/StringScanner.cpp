@@ -0,0 +1,140 @@
+#include "StringScanner.hpp"
+#include "WorkerPool.hpp"
+#include <algorithm>
+#include <array>
+#include <mutex>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// Same byte class the ASCII column shows as a character (isprint in the C locale), plus TAB.
+constexpr std::array<bool, 256> make_printable_table() {
+    std::array<bool, 256> t{};
+    for (int c = 0x20; c < 0x7F; ++c) t[static_cast<std::size_t>(c)] = true;
+    t['\t'] = true;
+    return t;
+}
+
+constexpr std::array<bool, 256> kPrintable = make_printable_table();
+
+#if defined(__SSE2__)
+// Bit i set when p[i] is printable. Bytes >= 0x80 are negative as signed chars,
+// so the signed range compare rejects them for free.
+inline unsigned printable_mask16(const unsigned char* p) {
+    const __m128i v   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    const __m128i ge  = _mm_cmpgt_epi8(v, _mm_set1_epi8(0x1F));
+    const __m128i le  = _mm_cmplt_epi8(v, _mm_set1_epi8(0x7F));
+    const __m128i tab = _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'));
+    return static_cast<unsigned>(_mm_movemask_epi8(_mm_or_si128(_mm_and_si128(ge, le), tab)));
+}
+#endif
+
+// Number of leading bytes in [p,end) whose printable class equals `want`.
+std::size_t run_length(const unsigned char* p, const unsigned char* end, bool want) {
+    const unsigned char* s = p;
+#if defined(__SSE2__)
+    while (end - p >= 16) {
+        unsigned m = printable_mask16(p);
+        if (want) m = ~m & 0xFFFFu;
+        if (m != 0) return static_cast<std::size_t>(p - s) + static_cast<unsigned>(__builtin_ctz(m));
+        p += 16;
+    }
+#endif
+    while (p < end && kPrintable[*p] == want) ++p;
+    return static_cast<std::size_t>(p - s);
+}
+
+void scan_ascii(const unsigned char* data, std::size_t n, std::size_t begin, std::size_t end,
+                std::size_t min_len, std::vector<StringHit>& out) {
+    std::size_t i = begin;
+    // A run that started in an earlier chunk belongs to that chunk.
+    if (i > 0 && i < n && kPrintable[data[i - 1]]) i += run_length(data + i, data + n, true);
+
+    while (i < end) {
+        i += run_length(data + i, data + end, false);
+        if (i >= end) break;
+        std::size_t len = run_length(data + i, data + n, true);
+        if (len >= min_len) out.push_back({i, static_cast<std::uint32_t>(std::min<std::size_t>(len, UINT32_MAX)), false});
+        i += len;
+    }
+}
+
+void scan_utf16le(const unsigned char* data, std::size_t n, std::size_t begin, std::size_t end,
+                  std::size_t min_len, std::vector<StringHit>& out) {
+    auto valid = [&](std::size_t k) {
+        return k + 1 < n && data[k + 1] == 0 && kPrintable[data[k]];
+    };
+
+    for (std::size_t i = begin; i < end; ++i) {
+        if (!valid(i)) continue;
+        if (i >= 2 && valid(i - 2)) continue; // continuation of an earlier run
+
+        std::size_t j = i;
+        while (valid(j)) j += 2;
+        if ((j - i) / 2 >= min_len)
+            out.push_back({i, static_cast<std::uint32_t>(std::min<std::size_t>(j - i, UINT32_MAX)), true});
+    }
+}
+
+} // namespace
+
+bool StringScanner::is_printable(unsigned char c) {
+    return kPrintable[c];
+}
+
+void StringScanner::scan_range(const unsigned char* data, std::size_t n,
+                               std::size_t begin, std::size_t end,
+                               const StringScanOptions& opts,
+                               std::vector<StringHit>& out) {
+    end = std::min(end, n);
+    if (begin >= end) return;
+
+    const std::size_t min_len = std::max<std::size_t>(1, opts.min_length);
+    const std::size_t first = out.size();
+
+    if (opts.ascii) scan_ascii(data, n, begin, end, min_len, out);
+    const std::size_t mid = out.size();
+    if (opts.utf16le) scan_utf16le(data, n, begin, end, min_len, out);
+
+    auto by_offset = [](const StringHit& a, const StringHit& b) { return a.offset < b.offset; };
+    std::inplace_merge(out.begin() + static_cast<long>(first),
+                       out.begin() + static_cast<long>(mid),
+                       out.end(), by_offset);
+}
+
+void StringScanner::scan(const unsigned char* data, std::size_t n,
+                         const StringScanOptions& opts,
+                         const BatchCallback& on_batch,
+                         const std::atomic<bool>* cancel) {
+    if (n == 0 || !on_batch) return;
+
+    const std::size_t chunk = std::max<std::size_t>(opts.chunk_size, 64u << 10);
+    const std::size_t nchunks = (n + chunk - 1) / chunk;
+
+    std::vector<std::vector<StringHit>> results(nchunks);
+    std::vector<char> ready(nchunks, 0);
+    std::mutex mu;
+    std::size_t emitted = 0;
+
+    auto cancelled = [cancel] { return cancel && cancel->load(std::memory_order_relaxed); };
+
+    WorkerPool::shared().parallel_for(nchunks, [&](std::size_t k) {
+        if (cancelled()) return;
+
+        std::vector<StringHit> local;
+        scan_range(data, n, k * chunk, std::min(n, (k + 1) * chunk), opts, local);
+
+        std::lock_guard<std::mutex> lock(mu);
+        results[k] = std::move(local);
+        ready[k] = 1;
+        // Deliver in order so consumers can append without re-sorting.
+        while (emitted < nchunks && ready[emitted]) {
+            if (!cancelled()) on_batch(std::move(results[emitted]));
+            results[emitted] = std::vector<StringHit>();
+            ++emitted;
+        }
+    });
+}
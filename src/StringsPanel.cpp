@@ -0,0 +1,238 @@
+#include "StringsPanel.hpp"
+#include "WorkerPool.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+namespace {
+constexpr std::size_t kMaxPreviewChars = 160;
+}
+
+StringsPanel::StringsPanel()
+    : Gtk::Box(Gtk::ORIENTATION_VERTICAL),
+      m_vadj(Gtk::Adjustment::create(0, 0, 0, 1, 10, 10)),
+      m_vscroll(m_vadj, Gtk::ORIENTATION_VERTICAL) {
+    m_min_len.set_range(2, 256);
+    m_min_len.set_increments(1, 4);
+    m_min_len.set_value(4);
+    m_ascii.set_active(true);
+    m_utf16.set_active(true);
+
+    m_controls.set_spacing(6);
+    m_controls.pack_start(m_min_label, Gtk::PACK_SHRINK);
+    m_controls.pack_start(m_min_len, Gtk::PACK_SHRINK);
+    m_controls.pack_start(m_ascii, Gtk::PACK_SHRINK);
+    m_controls.pack_start(m_utf16, Gtk::PACK_SHRINK);
+    m_controls.pack_end(m_scan_button, Gtk::PACK_SHRINK);
+
+    m_summary.set_halign(Gtk::ALIGN_START);
+
+    m_list.add_events(Gdk::SCROLL_MASK | Gdk::SMOOTH_SCROLL_MASK | Gdk::BUTTON_PRESS_MASK);
+    m_list_box.pack_start(m_list, Gtk::PACK_EXPAND_WIDGET);
+    m_list_box.pack_start(m_vscroll, Gtk::PACK_SHRINK);
+
+    set_spacing(4);
+    pack_start(m_controls, Gtk::PACK_SHRINK);
+    pack_start(m_summary, Gtk::PACK_SHRINK);
+    pack_start(m_list_box, Gtk::PACK_EXPAND_WIDGET);
+
+    m_scan_button.signal_clicked().connect(sigc::mem_fun(*this, &StringsPanel::start_scan));
+    m_dispatcher.connect(sigc::mem_fun(*this, &StringsPanel::on_dispatch));
+    m_vadj->signal_value_changed().connect([this] { m_list.queue_draw(); });
+    m_list.signal_draw().connect(sigc::mem_fun(*this, &StringsPanel::on_list_draw));
+    m_list.signal_scroll_event().connect(sigc::mem_fun(*this, &StringsPanel::on_list_scroll));
+    m_list.signal_button_press_event().connect(sigc::mem_fun(*this, &StringsPanel::on_list_button_press));
+    m_list.signal_size_allocate().connect(sigc::mem_fun(*this, &StringsPanel::on_list_size_allocate));
+
+    update_summary();
+    show_all_children();
+}
+
+StringsPanel::~StringsPanel() {
+    invalidate();
+}
+
+void StringsPanel::set_buffer(const HexBuffer* buffer) {
+    invalidate();
+    m_buffer = buffer;
+}
+
+void StringsPanel::invalidate() {
+    m_cancel = true;
+    if (m_job.valid()) m_job.wait();
+    m_cancel = false;
+
+    {
+        std::lock_guard<std::mutex> lock(m_pending_mutex);
+        m_pending.clear();
+        m_scan_done = false;
+    }
+    m_scanning = false;
+    m_from_cache = false;
+    m_hits.clear();
+    m_hits.shrink_to_fit();
+    m_selected = static_cast<std::size_t>(-1);
+    m_vadj->set_value(0);
+    update_range();
+    update_summary();
+    m_list.queue_draw();
+}
+
+void StringsPanel::start_scan() {
+    invalidate();
+    if (!m_buffer || m_buffer->data.empty()) return;
+    if (!m_ascii.get_active() && !m_utf16.get_active()) return;
+
+    StringScanOptions opts;
+    opts.min_length = static_cast<std::size_t>(m_min_len.get_value_as_int());
+    opts.ascii = m_ascii.get_active();
+    opts.utf16le = m_utf16.get_active();
+
+    const unsigned char* data = m_buffer->data.data();
+    const std::size_t n = m_buffer->data.size();
+
+    if (m_cache && m_cache->strings(data, n, opts, m_hits)) {
+        m_from_cache = true;
+        update_range();
+        update_summary();
+        m_list.queue_draw();
+        return;
+    }
+
+    m_scan_opts = opts;
+    m_scanning = true;
+    update_summary();
+
+    m_job = WorkerPool::shared().submit([this, data, n, opts] {
+        StringScanner::scan(data, n, opts, [this](std::vector<StringHit>&& batch) {
+            if (batch.empty()) return;
+            {
+                std::lock_guard<std::mutex> lock(m_pending_mutex);
+                m_pending.insert(m_pending.end(), batch.begin(), batch.end());
+            }
+            m_dispatcher.emit();
+        }, &m_cancel);
+
+        {
+            std::lock_guard<std::mutex> lock(m_pending_mutex);
+            m_scan_done = true;
+        }
+        m_dispatcher.emit();
+    });
+}
+
+void StringsPanel::on_dispatch() {
+    bool done = false;
+    {
+        std::lock_guard<std::mutex> lock(m_pending_mutex);
+        m_hits.insert(m_hits.end(), m_pending.begin(), m_pending.end());
+        m_pending.clear();
+        done = m_scan_done;
+        m_scan_done = false;
+    }
+
+    if (done && m_scanning) {
+        if (m_job.valid()) m_job.get();
+        m_scanning = false;
+        if (m_cache) m_cache->store_strings(m_scan_opts, m_hits);
+    }
+    update_range();
+    update_summary();
+    m_list.queue_draw();
+}
+
+void StringsPanel::update_range() {
+    const int h = std::max(1, m_list.get_allocated_height());
+    const double page = static_cast<double>(std::max(1, h / std::max(1, m_row_height)));
+    m_vadj->configure(std::min(m_vadj->get_value(), static_cast<double>(m_hits.size())),
+                      0, static_cast<double>(m_hits.size()), 1, page, page);
+}
+
+void StringsPanel::update_summary() {
+    char text[96];
+    std::snprintf(text, sizeof(text), "%zu strings%s", m_hits.size(),
+                  m_scanning ? " (scanning...)" : m_from_cache ? " (cached)" : "");
+    m_summary.set_text(text);
+}
+
+void StringsPanel::on_list_size_allocate(Gtk::Allocation&) {
+    update_range();
+}
+
+bool StringsPanel::on_list_draw(const Cairo::RefPtr<Cairo::Context>& cr) {
+    auto layout = m_list.create_pango_layout("0");
+    layout->set_font_description(Pango::FontDescription("Monospace 10"));
+    int w = 0, h = 0;
+    layout->get_pixel_size(w, h);
+    if (h > 0 && h != m_row_height) {
+        m_row_height = h;
+        update_range();
+    }
+
+    const int height = m_list.get_allocated_height();
+    const int width = m_list.get_allocated_width();
+    const std::size_t first = static_cast<std::size_t>(m_vadj->get_value());
+    const std::size_t rows = static_cast<std::size_t>(height / m_row_height + 1);
+    const auto fg = m_list.get_style_context()->get_color(Gtk::STATE_FLAG_NORMAL);
+
+    // Hits may go stale if the buffer shrinks under us; clamp to what exists.
+    const unsigned char* data = m_buffer ? m_buffer->data.data() : nullptr;
+    const std::size_t size = m_buffer ? m_buffer->data.size() : 0;
+
+    std::string line;
+    line.reserve(kMaxPreviewChars + 32);
+
+    for (std::size_t r = 0; r < rows && first + r < m_hits.size(); ++r) {
+        const std::size_t idx = first + r;
+        const StringHit& hit = m_hits[idx];
+        const int y = static_cast<int>(r) * m_row_height;
+
+        if (idx == m_selected) {
+            cr->set_source_rgba(0.25, 0.45, 0.85, 0.35);
+            cr->rectangle(0, y, width, m_row_height);
+            cr->fill();
+        }
+
+        char head[40];
+        std::snprintf(head, sizeof(head), "%010zX  %s  ", hit.offset, hit.utf16 ? "U" : "A");
+        line.assign(head);
+
+        const std::size_t step = hit.utf16 ? 2 : 1;
+        std::size_t end = std::min<std::size_t>(hit.offset + hit.length, size);
+        std::size_t shown = 0;
+        for (std::size_t i = hit.offset; i < end && shown < kMaxPreviewChars; i += step, ++shown) {
+            unsigned char c = data[i];
+            line.push_back(StringScanner::is_printable(c) && c != '\t' ? static_cast<char>(c) : ' ');
+        }
+        if (shown == kMaxPreviewChars && hit.length / step > kMaxPreviewChars) line += "...";
+
+        layout->set_text(line);
+        cr->set_source_rgba(fg.get_red(), fg.get_green(), fg.get_blue(), fg.get_alpha());
+        cr->move_to(4, y);
+        layout->show_in_cairo_context(cr);
+    }
+    return true;
+}
+
+bool StringsPanel::on_list_scroll(GdkEventScroll* ev) {
+    double delta = 0;
+    if (ev->direction == GDK_SCROLL_UP) delta = -3;
+    else if (ev->direction == GDK_SCROLL_DOWN) delta = 3;
+    else if (ev->direction == GDK_SCROLL_SMOOTH) delta = ev->delta_y * 3;
+
+    const double upper = std::max(0.0, m_vadj->get_upper() - m_vadj->get_page_size());
+    m_vadj->set_value(std::clamp(m_vadj->get_value() + delta, 0.0, upper));
+    return true;
+}
+
+bool StringsPanel::on_list_button_press(GdkEventButton* ev) {
+    if (ev->button != 1) return false;
+    const std::size_t idx = static_cast<std::size_t>(m_vadj->get_value()) +
+                            static_cast<std::size_t>(std::max(0.0, ev->y) / m_row_height);
+    if (idx >= m_hits.size()) return false;
+
+    m_selected = idx;
+    m_list.queue_draw();
+    m_signal_offset_activated.emit(m_hits[idx].offset);
+    return true;
+}
@@ -0,0 +1,570 @@
+#include "StructTemplate.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <map>
+
+namespace {
+
+struct Token {
+    enum Kind { Ident, Number, Punct, End } kind{End};
+    std::string text;
+    std::uint64_t value{0};
+    int line{1};
+};
+
+bool tokenize(const std::string& src, std::vector<Token>& out, std::string& error) {
+    int line = 1;
+    std::size_t i = 0;
+    while (i < src.size()) {
+        unsigned char c = static_cast<unsigned char>(src[i]);
+        if (c == '\n') { ++line; ++i; continue; }
+        if (std::isspace(c)) { ++i; continue; }
+        if (c == '#' || (c == '/' && i + 1 < src.size() && src[i + 1] == '/')) {
+            while (i < src.size() && src[i] != '\n') ++i;
+            continue;
+        }
+
+        Token t;
+        t.line = line;
+        if (std::isalpha(c) || c == '_') {
+            std::size_t s = i;
+            while (i < src.size() && (std::isalnum(static_cast<unsigned char>(src[i])) || src[i] == '_')) ++i;
+            t.kind = Token::Ident;
+            t.text = src.substr(s, i - s);
+        } else if (std::isdigit(c)) {
+            std::size_t s = i;
+            while (i < src.size() && std::isalnum(static_cast<unsigned char>(src[i]))) ++i;
+            t.kind = Token::Number;
+            t.text = src.substr(s, i - s);
+            char* end = nullptr;
+            t.value = std::strtoull(t.text.c_str(), &end, 0);
+            if (!end || *end != '\0') {
+                error = "line " + std::to_string(line) + ": bad number '" + t.text + "'";
+                return false;
+            }
+        } else if (std::strchr("{}[];@", c)) {
+            t.kind = Token::Punct;
+            t.text = std::string(1, static_cast<char>(c));
+            ++i;
+        } else {
+            error = "line " + std::to_string(line) + ": unexpected character '" + std::string(1, static_cast<char>(c)) + "'";
+            return false;
+        }
+        out.push_back(std::move(t));
+    }
+    Token end;
+    end.line = line;
+    out.push_back(end);
+    return true;
+}
+
+bool parse_prim(const std::string& s, StructTemplate::Type& t) {
+    static const std::pair<const char*, StructTemplate::Type> kPrims[] = {
+        {"u8", StructTemplate::Type::U8},   {"u16", StructTemplate::Type::U16},
+        {"u32", StructTemplate::Type::U32}, {"u64", StructTemplate::Type::U64},
+        {"i8", StructTemplate::Type::I8},   {"i16", StructTemplate::Type::I16},
+        {"i32", StructTemplate::Type::I32}, {"i64", StructTemplate::Type::I64},
+        {"f32", StructTemplate::Type::F32}, {"f64", StructTemplate::Type::F64},
+        {"char", StructTemplate::Type::Char},
+    };
+    for (const auto& p : kPrims) {
+        if (s == p.first) { t = p.second; return true; }
+    }
+    return false;
+}
+
+std::uint64_t read_uint(const unsigned char* p, std::size_t size, bool big_endian) {
+    std::uint64_t v = 0;
+    if (big_endian) {
+        for (std::size_t i = 0; i < size; ++i) v = (v << 8) | p[i];
+    } else {
+        for (std::size_t i = size; i-- > 0;) v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+} // namespace
+
+// Parses the source into struct definitions, then inlines the root struct into
+// the flat op list of a StructTemplate.
+class TemplateCompiler {
+public:
+    TemplateCompiler(StructTemplate& t, std::string& error) : m_t(t), m_error(error) {}
+
+    bool run(const std::string& source) {
+        if (!tokenize(source, m_toks, m_error)) return false;
+        if (!parse_file()) return false;
+        if (m_structs.empty()) return fail("no struct defined");
+
+        const std::size_t root = m_structs.size() - 1;
+        m_t.m_root_name = m_structs[root].name;
+        return emit_struct(root, m_structs[root].name, 0, false);
+    }
+
+private:
+    using Type = StructTemplate::Type;
+    using Op = StructTemplate::Op;
+    using OpCode = StructTemplate::OpCode;
+
+    struct Member {
+        std::string name;
+        Type type{Type::U8};
+        int struct_index{-1};
+        bool big_endian{false};
+        bool is_array{false};
+        std::uint64_t count{1};
+        std::string count_ref;
+        std::string at_ref;
+        int line{0};
+    };
+
+    struct StructDef {
+        std::string name;
+        std::vector<Member> members;
+    };
+
+    StructTemplate& m_t;
+    std::string& m_error;
+    std::vector<Token> m_toks;
+    std::size_t m_pos{0};
+    std::vector<StructDef> m_structs;
+    bool m_default_big{false};
+    int m_next_reg{0};
+
+    const Token& peek() const { return m_toks[m_pos]; }
+    const Token& next() { return m_toks[m_pos < m_toks.size() - 1 ? m_pos++ : m_pos]; }
+
+    bool fail(const std::string& msg) {
+        m_error = "line " + std::to_string(peek().line) + ": " + msg;
+        return false;
+    }
+    bool accept(const char* punct) {
+        if (peek().kind == Token::Punct && peek().text == punct) { ++m_pos; return true; }
+        return false;
+    }
+    bool expect(const char* punct) {
+        if (accept(punct)) return true;
+        return fail(std::string("expected '") + punct + "'");
+    }
+    bool expect_ident(std::string& out) {
+        if (peek().kind != Token::Ident) return fail("expected identifier");
+        out = next().text;
+        return true;
+    }
+    bool parse_endian(bool& big) {
+        std::string v;
+        if (!expect_ident(v)) return false;
+        if (v == "little") big = false;
+        else if (v == "big") big = true;
+        else return fail("endian must be 'little' or 'big'");
+        return expect(";");
+    }
+
+    int find_struct(const std::string& name) const {
+        for (std::size_t i = 0; i < m_structs.size(); ++i)
+            if (m_structs[i].name == name) return static_cast<int>(i);
+        return -1;
+    }
+
+    bool parse_file() {
+        while (peek().kind != Token::End) {
+            std::string kw;
+            if (!expect_ident(kw)) return false;
+            if (kw == "endian") {
+                if (!parse_endian(m_default_big)) return false;
+            } else if (kw == "struct") {
+                if (!parse_struct()) return false;
+            } else {
+                --m_pos;
+                return fail("expected 'struct' or 'endian'");
+            }
+        }
+        return true;
+    }
+
+    bool parse_struct() {
+        StructDef def;
+        if (!expect_ident(def.name)) return false;
+        if (find_struct(def.name) >= 0) return fail("struct '" + def.name + "' redefined");
+        if (!expect("{")) return false;
+
+        bool big = m_default_big;
+        while (!accept("}")) {
+            if (peek().kind == Token::End) return fail("unterminated struct '" + def.name + "'");
+
+            Member m;
+            m.line = peek().line;
+            std::string word;
+            if (!expect_ident(word)) return false;
+            if (word == "endian") {
+                if (!parse_endian(big)) return false;
+                continue;
+            }
+
+            m.big_endian = big;
+            if (word == "le" || word == "be") {
+                m.big_endian = (word == "be");
+                if (!expect_ident(word)) return false;
+            }
+            if (!parse_prim(word, m.type)) {
+                m.struct_index = find_struct(word);
+                if (m.struct_index < 0) { --m_pos; return fail("unknown type '" + word + "'"); }
+                m.type = Type::Struct;
+            }
+            if (!expect_ident(m.name)) return false;
+
+            if (accept("[")) {
+                m.is_array = true;
+                if (peek().kind == Token::Number) m.count = next().value;
+                else if (!expect_ident(m.count_ref)) return false;
+                if (!expect("]")) return false;
+            }
+            if (accept("@") && !expect_ident(m.at_ref)) return false;
+            if (!expect(";")) return false;
+            def.members.push_back(std::move(m));
+        }
+        accept(";");
+        m_structs.push_back(std::move(def));
+        return true;
+    }
+
+    std::uint32_t intern(const std::string& name) {
+        m_t.m_names.push_back(name);
+        return static_cast<std::uint32_t>(m_t.m_names.size() - 1);
+    }
+
+    Op make(OpCode code, const std::string& name, int depth) {
+        Op op{};
+        op.code = code;
+        op.name = intern(name);
+        op.depth = static_cast<std::uint8_t>(depth);
+        return op;
+    }
+
+    // Returns the register holding an earlier scalar integer field of this instance.
+    bool resolve(const std::map<std::string, std::size_t>& scope, const std::string& ref,
+                 int line, std::int16_t& reg) {
+        auto it = scope.find(ref);
+        if (it == scope.end()) {
+            m_error = "line " + std::to_string(line) + ": '" + ref + "' is not an earlier scalar field";
+            return false;
+        }
+        Op& src = m_t.m_ops[it->second];
+        if (src.type == Type::F32 || src.type == Type::F64) {
+            m_error = "line " + std::to_string(line) + ": '" + ref + "' is not an integer";
+            return false;
+        }
+        if (src.reg < 0) {
+            if (m_next_reg >= static_cast<int>(StructTemplate::kMaxRegs)) {
+                m_error = "line " + std::to_string(line) + ": too many referenced fields";
+                return false;
+            }
+            src.reg = static_cast<std::int16_t>(m_next_reg++);
+        }
+        reg = src.reg;
+        return true;
+    }
+
+    // Bytes consumed by ops [from, to) if that never depends on data, else 0.
+    std::uint64_t fixed_size(std::size_t from, std::size_t to) const {
+        std::uint64_t total = 0;
+        for (std::size_t i = from; i < to; ++i) {
+            const Op& op = m_t.m_ops[i];
+            switch (op.code) {
+            case OpCode::Field:
+                if (op.count_reg >= 0) return 0;
+                total += op.count * StructTemplate::type_size(op.type);
+                break;
+            case OpCode::LoopBegin:
+                if (op.count_reg >= 0 || op.fixed_size == 0) return 0;
+                total += op.count * op.fixed_size;
+                i = op.jump;
+                break;
+            case OpCode::AtBegin:
+                return 0;
+            default:
+                break;
+            }
+        }
+        return total;
+    }
+
+    bool emit_struct(std::size_t idx, const std::string& name, int depth, bool element) {
+        if (depth + 2 >= static_cast<int>(StructTemplate::kMaxDepth)) return fail("structs nested too deeply");
+
+        Op begin = make(OpCode::StructBegin, name, depth);
+        begin.element = element;
+        m_t.m_ops.push_back(begin);
+
+        std::map<std::string, std::size_t> scope;
+        const StructDef& def = m_structs[idx];
+        std::uint8_t color = 0;
+
+        for (const Member& m : def.members) {
+            std::int16_t count_reg = -1, at_reg = -1;
+            if (!m.count_ref.empty() && !resolve(scope, m.count_ref, m.line, count_reg)) return false;
+            if (!m.at_ref.empty()) {
+                if (!resolve(scope, m.at_ref, m.line, at_reg)) return false;
+                Op at = make(OpCode::AtBegin, m.name, depth + 1);
+                at.at_reg = at_reg;
+                m_t.m_ops.push_back(at);
+                m_t.m_has_seeks = true;
+            }
+
+            if (m.type != Type::Struct) {
+                Op f = make(OpCode::Field, m.name, depth + 1);
+                f.type = m.type;
+                f.big_endian = m.big_endian;
+                f.count = m.count;
+                f.count_reg = count_reg;
+                f.color = static_cast<std::uint8_t>(color++ % StructTemplate::kColors);
+                m_t.m_ops.push_back(f);
+                if (!m.is_array) scope[m.name] = m_t.m_ops.size() - 1;
+            } else if (m.is_array) {
+                const std::size_t loop = m_t.m_ops.size();
+                Op lb = make(OpCode::LoopBegin, m.name, depth + 1);
+                lb.type = Type::Struct;
+                lb.count = m.count;
+                lb.count_reg = count_reg;
+                m_t.m_ops.push_back(lb);
+
+                const std::string elem_name = m_t.m_names[lb.name];
+                if (!emit_struct(static_cast<std::size_t>(m.struct_index), elem_name, depth + 2, true)) return false;
+
+                Op le = make(OpCode::LoopEnd, m.name, depth + 1);
+                le.jump = static_cast<std::uint32_t>(loop);
+                m_t.m_ops.push_back(le);
+                m_t.m_ops[loop].jump = static_cast<std::uint32_t>(m_t.m_ops.size() - 1);
+                m_t.m_ops[loop].fixed_size = fixed_size(loop + 1, m_t.m_ops.size() - 1);
+            } else {
+                if (!emit_struct(static_cast<std::size_t>(m.struct_index), m.name, depth + 1, false)) return false;
+            }
+
+            if (!m.at_ref.empty()) m_t.m_ops.push_back(make(OpCode::AtEnd, m.name, depth + 1));
+        }
+
+        m_t.m_ops.push_back(make(OpCode::StructEnd, name, depth));
+        return true;
+    }
+};
+
+bool StructTemplate::compile(const std::string& source, std::string& error) {
+    m_ops.clear();
+    m_names.clear();
+    m_root_name.clear();
+    m_has_seeks = false;
+
+    TemplateCompiler compiler(*this, error);
+    if (compiler.run(source)) return true;
+
+    m_ops.clear();
+    m_names.clear();
+    m_root_name.clear();
+    return false;
+}
+
+std::size_t StructTemplate::type_size(Type t) {
+    switch (t) {
+    case Type::U8: case Type::I8: case Type::Char: return 1;
+    case Type::U16: case Type::I16: return 2;
+    case Type::U32: case Type::I32: case Type::F32: return 4;
+    case Type::U64: case Type::I64: case Type::F64: return 8;
+    case Type::Struct: return 0;
+    }
+    return 0;
+}
+
+const char* StructTemplate::type_name(Type t) {
+    switch (t) {
+    case Type::U8: return "u8";
+    case Type::U16: return "u16";
+    case Type::U32: return "u32";
+    case Type::U64: return "u64";
+    case Type::I8: return "i8";
+    case Type::I16: return "i16";
+    case Type::I32: return "i32";
+    case Type::I64: return "i64";
+    case Type::F32: return "f32";
+    case Type::F64: return "f64";
+    case Type::Char: return "char";
+    case Type::Struct: return "struct";
+    }
+    return "?";
+}
+
+void StructTemplate::format_value(const Field& f, const unsigned char* data, std::size_t n,
+                                  char* buf, std::size_t buf_len) {
+    if (buf_len == 0) return;
+    buf[0] = '\0';
+    const std::size_t elem = type_size(f.type);
+    if (f.type == Type::Struct || elem == 0 || f.offset >= n || n - f.offset < elem) return;
+
+    const unsigned char* p = data + f.offset;
+    if (f.type == Type::Char) {
+        std::size_t len = std::min<std::size_t>({f.count, n - f.offset, buf_len - 3});
+        std::size_t o = 0;
+        buf[o++] = '"';
+        for (std::size_t i = 0; i < len; ++i) {
+            if (p[i] == 0 && f.count > 1) break;
+            buf[o++] = (p[i] >= 0x20 && p[i] < 0x7F) ? static_cast<char>(p[i]) : '.';
+        }
+        buf[o++] = '"';
+        buf[o] = '\0';
+        return;
+    }
+
+    const std::uint64_t raw = read_uint(p, elem, f.big_endian);
+    const int shift = static_cast<int>(64 - elem * 8);
+    int w = 0;
+    switch (f.type) {
+    case Type::I8: case Type::I16: case Type::I32: case Type::I64: {
+        const std::int64_t v = static_cast<std::int64_t>(raw << shift) >> shift;
+        w = std::snprintf(buf, buf_len, "%" PRId64, v);
+        break;
+    }
+    case Type::F32: {
+        float v;
+        std::uint32_t r = static_cast<std::uint32_t>(raw);
+        std::memcpy(&v, &r, sizeof(v));
+        w = std::snprintf(buf, buf_len, "%g", static_cast<double>(v));
+        break;
+    }
+    case Type::F64: {
+        double v;
+        std::memcpy(&v, &raw, sizeof(v));
+        w = std::snprintf(buf, buf_len, "%g", v);
+        break;
+    }
+    default:
+        w = std::snprintf(buf, buf_len, "%" PRIu64 " (0x%" PRIX64 ")", raw, raw);
+        break;
+    }
+    if (f.count > 1 && w > 0 && static_cast<std::size_t>(w) + 5 < buf_len)
+        std::snprintf(buf + w, buf_len - static_cast<std::size_t>(w), ", ...");
+}
+
+std::size_t StructTemplate::decode(const unsigned char* data, std::size_t n, std::size_t base,
+                                   std::size_t win_begin, std::size_t win_end,
+                                   Field* out, std::size_t cap, bool leaves_only) const {
+    struct Loop { std::size_t pc, count, index, out_idx, start; };
+    struct Frame { std::size_t out_idx, start; };
+
+    std::array<std::uint64_t, kMaxRegs> regs{};
+    std::array<Loop, kMaxDepth> loops;
+    std::array<Frame, kMaxDepth> frames;
+    std::array<std::size_t, kMaxDepth> seeks;
+    std::size_t nloops = 0, nframes = 0, nseeks = 0;
+
+    const std::size_t none = static_cast<std::size_t>(-1);
+    std::size_t written = 0;
+    std::size_t cursor = base;
+    std::size_t steps = 0;
+
+    auto overlaps = [&](std::size_t off, std::size_t size) {
+        return off < win_end && (off + size > win_begin || (size == 0 && off >= win_begin));
+    };
+    auto emit = [&](const Op& op, std::size_t off, std::size_t size, std::uint32_t count,
+                    std::int32_t index) -> std::size_t {
+        if (written >= cap) return none;
+        out[written] = {off, size, m_names[op.name].c_str(), count, index,
+                        op.code == OpCode::Field ? op.type : Type::Struct,
+                        op.depth, op.color, op.big_endian};
+        return written++;
+    };
+
+    bool stop = false;
+    for (std::size_t pc = 0; !stop && pc < m_ops.size() && steps < kMaxSteps; ++pc, ++steps) {
+        const Op& op = m_ops[pc];
+
+        // Past the window with nothing able to seek back: the rest is invisible.
+        if (cursor >= win_end && !m_has_seeks) break;
+
+        switch (op.code) {
+        case OpCode::Field: {
+            const std::size_t elem = type_size(op.type);
+            const std::uint64_t count = op.count_reg >= 0 ? regs[static_cast<std::size_t>(op.count_reg)] : op.count;
+            if (cursor > n || count > (n - cursor) / elem) { stop = true; break; } // runs off the data
+            const std::size_t size = static_cast<std::size_t>(count) * elem;
+
+            if (op.reg >= 0 && count >= 1)
+                regs[static_cast<std::size_t>(op.reg)] = read_uint(data + cursor, elem, op.big_endian);
+            if (overlaps(cursor, size))
+                emit(op, cursor, size, static_cast<std::uint32_t>(std::min<std::uint64_t>(count, UINT32_MAX)), -1);
+            cursor += size;
+            break;
+        }
+        case OpCode::StructBegin: {
+            std::int32_t index = -1;
+            if (op.element && nloops > 0) index = static_cast<std::int32_t>(loops[nloops - 1].index);
+            std::size_t idx = none;
+            if (!leaves_only && overlaps(cursor, 1)) idx = emit(op, cursor, 0, 1, index);
+            frames[nframes++] = {idx, cursor};
+            break;
+        }
+        case OpCode::StructEnd: {
+            const Frame& f = frames[--nframes];
+            if (f.out_idx != none) out[f.out_idx].size = cursor - f.start;
+            break;
+        }
+        case OpCode::LoopBegin: {
+            std::size_t count = static_cast<std::size_t>(op.count_reg >= 0 ? regs[static_cast<std::size_t>(op.count_reg)] : op.count);
+            if (op.fixed_size > 0) count = std::min<std::size_t>(count, (cursor <= n ? n - cursor : 0) / op.fixed_size);
+            count = std::min<std::size_t>(count, kMaxSteps);
+
+            std::size_t idx = none;
+            if (!leaves_only && overlaps(cursor, 1))
+                idx = emit(op, cursor, 0, static_cast<std::uint32_t>(count), -1);
+
+            // Constant-size elements let us jump straight to the first visible one.
+            std::size_t skip = 0;
+            const std::size_t start = cursor;
+            if (op.fixed_size > 0 && cursor < win_begin)
+                skip = std::min(count, (win_begin - cursor) / static_cast<std::size_t>(op.fixed_size));
+            cursor += skip * static_cast<std::size_t>(op.fixed_size);
+
+            if (skip >= count) {
+                cursor = start + count * static_cast<std::size_t>(op.fixed_size);
+                if (idx != none) out[idx].size = cursor - start;
+                pc = op.jump;
+                break;
+            }
+            loops[nloops++] = {pc, count, skip, idx, start};
+            break;
+        }
+        case OpCode::LoopEnd: {
+            Loop& l = loops[nloops - 1];
+            if (++l.index < l.count) {
+                pc = l.pc;
+            } else {
+                if (l.out_idx != none) out[l.out_idx].size = cursor - l.start;
+                --nloops;
+            }
+            break;
+        }
+        case OpCode::AtBegin: {
+            const std::uint64_t rel = regs[static_cast<std::size_t>(op.at_reg)];
+            if (rel > n || base > n - rel) { stop = true; break; }
+            seeks[nseeks++] = cursor;
+            cursor = base + static_cast<std::size_t>(rel);
+            break;
+        }
+        case OpCode::AtEnd:
+            cursor = seeks[--nseeks];
+            break;
+        }
+    }
+
+    // Close whatever was still open when decoding stopped early.
+    while (nloops > 0) {
+        const Loop& l = loops[--nloops];
+        if (l.out_idx != none) out[l.out_idx].size = cursor - l.start;
+    }
+    while (nframes > 0) {
+        const Frame& f = frames[--nframes];
+        if (f.out_idx != none) out[f.out_idx].size = cursor - f.start;
+    }
+    return written;
+}
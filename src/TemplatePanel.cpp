@@ -0,0 +1,145 @@
+#include "TemplatePanel.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+TemplatePanel::TemplatePanel() : Gtk::Box(Gtk::ORIENTATION_VERTICAL) {
+    m_controls.set_spacing(6);
+    m_controls.pack_start(m_load_button, Gtk::PACK_SHRINK);
+    m_controls.pack_start(m_apply_button, Gtk::PACK_SHRINK);
+    m_controls.pack_start(m_clear_button, Gtk::PACK_SHRINK);
+
+    m_summary.set_halign(Gtk::ALIGN_START);
+    m_summary.set_text("No template loaded.");
+
+    m_store = Gtk::TreeStore::create(m_columns);
+    m_tree.set_model(m_store);
+    m_tree.append_column("Field", m_columns.name);
+    m_tree.append_column("Type", m_columns.type);
+    m_tree.append_column("Offset", m_columns.offset_text);
+    m_tree.append_column("Value", m_columns.value);
+    m_scroll.add(m_tree);
+    m_scroll.set_policy(Gtk::POLICY_AUTOMATIC, Gtk::POLICY_AUTOMATIC);
+
+    set_spacing(4);
+    pack_start(m_controls, Gtk::PACK_SHRINK);
+    pack_start(m_summary, Gtk::PACK_SHRINK);
+    pack_start(m_scroll, Gtk::PACK_EXPAND_WIDGET);
+
+    m_fields.resize(kTreeCapacity);
+
+    m_load_button.signal_clicked().connect(sigc::mem_fun(*this, &TemplatePanel::on_load_clicked));
+    m_apply_button.signal_clicked().connect([this] { m_signal_apply_requested.emit(); });
+    m_clear_button.signal_clicked().connect(sigc::mem_fun(*this, &TemplatePanel::clear));
+    m_tree.signal_row_activated().connect(sigc::mem_fun(*this, &TemplatePanel::on_row_activated));
+
+    show_all_children();
+}
+
+void TemplatePanel::set_buffer(const HexBuffer* buffer) {
+    m_buffer = buffer;
+}
+
+void TemplatePanel::on_load_clicked() {
+    auto* parent = dynamic_cast<Gtk::Window*>(get_toplevel());
+    if (!parent) return;
+
+    Gtk::FileChooserDialog dialog(*parent, "Load Structure Template", Gtk::FILE_CHOOSER_ACTION_OPEN);
+    dialog.add_button("Cancel", Gtk::RESPONSE_CANCEL);
+    dialog.add_button("Load", Gtk::RESPONSE_OK);
+    if (dialog.run() != Gtk::RESPONSE_OK) return;
+
+    const auto path = dialog.get_filename();
+    std::ifstream file(path);
+    std::string source((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    std::string error;
+    if (!file || !m_template.compile(source, error)) {
+        Gtk::MessageDialog err(*parent, "Failed to load template.", false, Gtk::MESSAGE_ERROR, Gtk::BUTTONS_OK, true);
+        err.set_secondary_text(error.empty() ? path : error);
+        err.run();
+        clear();
+        return;
+    }
+
+    m_template_name = Glib::path_get_basename(path);
+    m_applied = false;
+    m_store->clear();
+    m_summary.set_text("Loaded " + m_template_name + " (root: " + m_template.root_name() + ")");
+    m_signal_template_changed.emit();
+}
+
+void TemplatePanel::apply_at(std::size_t base) {
+    if (m_template.empty()) return;
+    m_base = base;
+    m_applied = true;
+    rebuild_tree();
+    m_signal_template_changed.emit();
+}
+
+void TemplatePanel::refresh() {
+    if (m_applied) rebuild_tree();
+}
+
+void TemplatePanel::clear() {
+    m_applied = false;
+    m_store->clear();
+    m_summary.set_text(m_template.empty() ? "No template loaded." : "Loaded " + m_template_name);
+    m_signal_template_changed.emit();
+}
+
+void TemplatePanel::rebuild_tree() {
+    m_store->clear();
+    if (!m_buffer) return;
+
+    const auto& data = m_buffer->data;
+    const std::size_t count = m_template.decode(data.data(), data.size(), m_base,
+                                                0, static_cast<std::size_t>(-1),
+                                                m_fields.data(), m_fields.size());
+
+    // Fields arrive in pre-order with depths, so a stack of the last row per depth
+    // is enough to rebuild the hierarchy.
+    std::vector<Gtk::TreeRow> parents;
+    char text[160];
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto& f = m_fields[i];
+        Gtk::TreeRow row = (f.depth == 0 || parents.size() < f.depth)
+                               ? *m_store->append()
+                               : *m_store->append(parents[f.depth - 1].children());
+        parents.resize(f.depth);
+        parents.push_back(row);
+
+        if (f.index >= 0) std::snprintf(text, sizeof(text), "%s[%d]", f.name, f.index);
+        else std::snprintf(text, sizeof(text), "%s", f.name);
+        row[m_columns.name] = text;
+
+        if (f.type == StructTemplate::Type::Struct && f.index < 0 && f.count != 1)
+            std::snprintf(text, sizeof(text), "struct[%u]", f.count);
+        else if (f.count > 1)
+            std::snprintf(text, sizeof(text), "%s%s[%u]", f.big_endian ? "be " : "",
+                          StructTemplate::type_name(f.type), f.count);
+        else
+            std::snprintf(text, sizeof(text), "%s%s", f.big_endian && StructTemplate::type_size(f.type) > 1 ? "be " : "",
+                          StructTemplate::type_name(f.type));
+        row[m_columns.type] = text;
+
+        std::snprintf(text, sizeof(text), "0x%08zX", f.offset);
+        row[m_columns.offset_text] = text;
+        row[m_columns.offset] = f.offset;
+
+        StructTemplate::format_value(f, data.data(), data.size(), text, sizeof(text));
+        row[m_columns.value] = text;
+    }
+    m_tree.expand_all();
+
+    std::snprintf(text, sizeof(text), "%s at 0x%zX: %zu fields%s", m_template.root_name().c_str(), m_base,
+                  count, count == m_fields.size() ? " (truncated)" : "");
+    m_summary.set_text(text);
+}
+
+void TemplatePanel::on_row_activated(const Gtk::TreeModel::Path& path, Gtk::TreeViewColumn*) {
+    auto it = m_store->get_iter(path);
+    if (!it) return;
+    m_signal_offset_activated.emit(static_cast<std::size_t>((*it)[m_columns.offset]));
+}
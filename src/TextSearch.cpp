@@ -0,0 +1,784 @@
+#include "TextSearch.hpp"
+#include "WorkerPool.hpp"
+#include <algorithm>
+#include <bitset>
+#include <cctype>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <unordered_set>
+
+namespace {
+
+using ByteSet = std::bitset<256>;
+
+constexpr int kMaxRepeat = 1000;
+constexpr std::size_t kMaxNfaStates = 200000;
+constexpr std::size_t kMaxPrefix = 64;
+constexpr unsigned char kKeyVersion = 2;
+
+struct Node {
+    enum Kind { Set, Concat, Alt, Repeat };
+    explicit Node(Kind k) : kind(k) {}
+
+    Kind kind;
+    ByteSet set;
+    ByteSet high = ByteSet().set(0);   // Set: high byte of the code unit in UTF-16 modes
+    std::vector<Node> kids;
+    int min = 0;
+    int max = 0;   // Repeat: negative means unbounded
+};
+
+ByteSet fold_case(ByteSet s) {
+    for (int c = 'a'; c <= 'z'; ++c) {
+        if (s[static_cast<std::size_t>(c)] || s[static_cast<std::size_t>(c - 32)]) {
+            s.set(static_cast<std::size_t>(c));
+            s.set(static_cast<std::size_t>(c - 32));
+        }
+    }
+    return s;
+}
+
+ByteSet byte_range(int lo, int hi) {
+    ByteSet s;
+    for (int c = lo; c <= hi; ++c) s.set(static_cast<std::size_t>(c));
+    return s;
+}
+
+int only_byte(const ByteSet& s) {
+    if (s.count() != 1) return -1;
+    for (int c = 0; c < 256; ++c)
+        if (s[static_cast<std::size_t>(c)]) return c;
+    return -1;
+}
+
+// Decodes the UTF-8 sequence at s[pos], advancing past it. Overlong forms,
+// surrogates and values above U+10FFFF are rejected.
+bool decode_utf8(const std::string& s, std::size_t& pos, std::uint32_t& cp) {
+    const auto lead = static_cast<unsigned char>(s[pos]);
+    std::size_t len = 0;
+    if (lead < 0x80) { cp = lead; len = 1; }
+    else if ((lead & 0xE0) == 0xC0) { cp = lead & 0x1Fu; len = 2; }
+    else if ((lead & 0xF0) == 0xE0) { cp = lead & 0x0Fu; len = 3; }
+    else if ((lead & 0xF8) == 0xF0) { cp = lead & 0x07u; len = 4; }
+    else return false;
+    if (s.size() - pos < len) return false;
+    for (std::size_t i = 1; i < len; ++i) {
+        const auto c = static_cast<unsigned char>(s[pos + i]);
+        if ((c & 0xC0) != 0x80) return false;
+        cp = cp << 6 | (c & 0x3Fu);
+    }
+    static const std::uint32_t kMin[] = {0, 0, 0x80, 0x800, 0x10000};
+    if (cp < kMin[len] || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) return false;
+    pos += len;
+    return true;
+}
+
+Node code_unit(std::uint32_t unit) {
+    Node n{Node::Set};
+    n.set.set(unit & 0xFF);
+    n.high = ByteSet().set(unit >> 8);
+    return n;
+}
+
+// One character in a UTF-16 mode: a code unit, or a surrogate pair above U+FFFF.
+Node code_point(std::uint32_t cp, bool icase) {
+    if (cp >= 0x10000) {
+        Node pair{Node::Concat};
+        pair.kids.push_back(code_unit(0xD800 + ((cp - 0x10000) >> 10)));
+        pair.kids.push_back(code_unit(0xDC00 + ((cp - 0x10000) & 0x3FF)));
+        return pair;
+    }
+    Node n = code_unit(cp);
+    if (icase && cp < 0x80) n.set = fold_case(n.set);
+    return n;
+}
+
+int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+class Parser {
+public:
+    Parser(const std::string& src, bool icase, bool wide) : m_src(src), m_icase(icase), m_wide(wide) {}
+
+    bool parse(Node& out, std::string& error) {
+        out = alternation();
+        if (m_error.empty() && m_pos < m_src.size()) fail("unmatched ')'");
+        error = m_error;
+        return m_error.empty();
+    }
+
+private:
+    const std::string& m_src;
+    bool m_icase;
+    bool m_wide;   // UTF-16: non-ASCII characters are decoded to code units
+    std::size_t m_pos{0};
+    int m_depth{0};
+    std::string m_error;
+
+    bool done() const { return m_pos >= m_src.size() || !m_error.empty(); }
+    char peek() const { return m_src[m_pos]; }
+
+    void fail(const std::string& msg) {
+        if (m_error.empty()) m_error = msg + " at position " + std::to_string(m_pos);
+    }
+
+    Node set_node(const ByteSet& s) const {
+        Node n{Node::Set};
+        n.set = m_icase ? fold_case(s) : s;
+        return n;
+    }
+
+    Node alternation() {
+        Node first = concatenation();
+        if (done() || peek() != '|') return first;
+
+        Node alt{Node::Alt};
+        alt.kids.push_back(std::move(first));
+        while (!done() && peek() == '|') {
+            ++m_pos;
+            alt.kids.push_back(concatenation());
+        }
+        return alt;
+    }
+
+    Node concatenation() {
+        Node cat{Node::Concat};
+        while (!done() && peek() != '|' && peek() != ')') cat.kids.push_back(repetition());
+        return cat;
+    }
+
+    Node repetition() {
+        Node node = atom();
+        while (!done()) {
+            int lo = 0, hi = -1;
+            const char c = peek();
+            if (c == '*') { ++m_pos; }
+            else if (c == '+') { lo = 1; ++m_pos; }
+            else if (c == '?') { hi = 1; ++m_pos; }
+            else if (c == '{') { if (!bounds(lo, hi)) break; }
+            else break;
+
+            if (!done() && peek() == '?') {
+                fail("lazy quantifiers are not supported (matches are always longest)");
+                break;
+            }
+            Node rep{Node::Repeat};
+            rep.min = lo;
+            rep.max = hi;
+            rep.kids.push_back(std::move(node));
+            node = std::move(rep);
+        }
+        return node;
+    }
+
+    // {n}, {n,} or {n,m}
+    bool bounds(int& lo, int& hi) {
+        ++m_pos;
+        auto number = [this](int& v) {
+            const std::size_t start = m_pos;
+            v = 0;
+            while (m_pos < m_src.size() && m_src[m_pos] >= '0' && m_src[m_pos] <= '9') {
+                v = std::min(v * 10 + (m_src[m_pos] - '0'), kMaxRepeat + 1);
+                ++m_pos;
+            }
+            return m_pos > start;
+        };
+
+        if (!number(lo)) { fail("expected a repeat count"); return false; }
+        hi = lo;
+        if (m_pos < m_src.size() && m_src[m_pos] == ',') {
+            ++m_pos;
+            if (!number(hi)) hi = -1;
+        }
+        if (m_pos >= m_src.size() || m_src[m_pos] != '}') { fail("missing '}'"); return false; }
+        ++m_pos;
+
+        if (lo > kMaxRepeat || hi > kMaxRepeat) { fail("repeat count above 1000"); return false; }
+        if (hi >= 0 && hi < lo) { fail("repeat bounds out of order"); return false; }
+        return true;
+    }
+
+    Node atom() {
+        const char c = m_src[m_pos++];
+        switch (c) {
+        case '(': {
+            if (m_src.compare(m_pos, 2, "?:") == 0) m_pos += 2;
+            if (++m_depth > 200) fail("groups nested too deeply");
+            Node inner = alternation();
+            --m_depth;
+            if (done() || peek() != ')') fail("missing ')'");
+            else ++m_pos;
+            return inner;
+        }
+        case '.':
+            return set_node(ByteSet().set());
+        case '[':
+            return set_node(bracket());
+        case '\\':
+            return set_node(escape());
+        case '*': case '+': case '?': case '{':
+            --m_pos;
+            fail("nothing to repeat");
+            return Node{Node::Concat};
+        case '^': case '$':
+            --m_pos;
+            fail("anchors are not supported");
+            return Node{Node::Concat};
+        default:
+            if (m_wide && static_cast<unsigned char>(c) >= 0x80) {
+                std::uint32_t cp = 0;
+                if (!decode_utf8(m_src, --m_pos, cp)) {
+                    fail("invalid UTF-8");
+                    return Node{Node::Concat};
+                }
+                return code_point(cp, m_icase);
+            }
+            return set_node(ByteSet().set(static_cast<unsigned char>(c)));
+        }
+    }
+
+    ByteSet escape() {
+        if (m_pos >= m_src.size()) { fail("trailing backslash"); return {}; }
+        const char c = m_src[m_pos++];
+        const ByteSet digit = byte_range('0', '9');
+        const ByteSet word = digit | byte_range('a', 'z') | byte_range('A', 'Z') | ByteSet().set('_');
+        const ByteSet space = ByteSet().set(' ').set('\t').set('\n').set('\r').set('\f').set('\v');
+
+        switch (c) {
+        case 'd': return digit;
+        case 'D': return ~digit;
+        case 'w': return word;
+        case 'W': return ~word;
+        case 's': return space;
+        case 'S': return ~space;
+        case 'n': return ByteSet().set('\n');
+        case 'r': return ByteSet().set('\r');
+        case 't': return ByteSet().set('\t');
+        case 'f': return ByteSet().set('\f');
+        case 'v': return ByteSet().set('\v');
+        case '0': return ByteSet().set(0);
+        case 'x': {
+            const int hi = m_pos < m_src.size() ? hex_value(m_src[m_pos]) : -1;
+            const int lo = m_pos + 1 < m_src.size() ? hex_value(m_src[m_pos + 1]) : -1;
+            if (hi < 0 || lo < 0) { fail("\\x needs two hex digits"); return {}; }
+            m_pos += 2;
+            return ByteSet().set(static_cast<std::size_t>(hi * 16 + lo));
+        }
+        default:
+            if (std::isalnum(static_cast<unsigned char>(c))) {
+                --m_pos;
+                fail(std::string("unknown escape \\") + c);
+                return {};
+            }
+            return ByteSet().set(static_cast<unsigned char>(c));
+        }
+    }
+
+    ByteSet bracket() {
+        ByteSet s;
+        const bool negate = m_pos < m_src.size() && m_src[m_pos] == '^';
+        if (negate) ++m_pos;
+
+        // One byte of a range: a plain character or an escape naming a single byte.
+        auto range_end = [this](ByteSet& cls) {
+            const char c = m_src[m_pos++];
+            if (m_wide && static_cast<unsigned char>(c) >= 0x80) {
+                --m_pos;
+                fail("non-ASCII characters in [] are not supported in UTF-16 mode");
+                return -1;
+            }
+            if (c != '\\') return static_cast<int>(static_cast<unsigned char>(c));
+            cls = escape();
+            return only_byte(cls);
+        };
+
+        for (bool first = true;; first = false) {
+            if (!m_error.empty()) return s;
+            if (m_pos >= m_src.size()) { fail("missing ']'"); return s; }
+            if (m_src[m_pos] == ']' && !first) { ++m_pos; break; }
+
+            ByteSet cls;
+            const int lo = range_end(cls);
+            if (lo < 0) { s |= cls; continue; }   // \d, \w, ...
+
+            if (m_pos + 1 < m_src.size() && m_src[m_pos] == '-' && m_src[m_pos + 1] != ']') {
+                ++m_pos;
+                const int hi = range_end(cls);
+                if (hi < 0) { fail("invalid range"); return s; }
+                if (hi < lo) { fail("range out of order"); return s; }
+                s |= byte_range(lo, hi);
+            } else {
+                s.set(static_cast<std::size_t>(lo));
+            }
+        }
+        return negate ? ~s : s;
+    }
+};
+
+// Thompson NFA. Fragments have one entry and one dangling epsilon exit.
+struct Nfa {
+    enum Kind { Bytes, Epsilon, Match };
+    struct State {
+        Kind kind;
+        int set;
+        int out;
+        int out2;
+    };
+    struct Frag {
+        int start;
+        int end;
+    };
+
+    std::vector<State> states;
+    std::vector<ByteSet> sets;
+    TextEncoding encoding{TextEncoding::Ascii};
+    int start{0};
+    bool overflow{false};
+
+    int add(Kind kind, int set = -1) {
+        if (states.size() >= kMaxNfaStates) overflow = true;
+        states.push_back({kind, set, -1, -1});
+        return static_cast<int>(states.size() - 1);
+    }
+
+    Frag epsilon() {
+        const int e = add(Epsilon);
+        return {e, e};
+    }
+
+    Frag bytes(const ByteSet& s) {
+        sets.push_back(s);
+        const int st = add(Bytes, static_cast<int>(sets.size() - 1));
+        const int e = add(Epsilon);
+        states[static_cast<std::size_t>(st)].out = e;
+        return {st, e};
+    }
+
+    void link(Frag& a, const Frag& b) {
+        states[static_cast<std::size_t>(a.end)].out = b.start;
+        a.end = b.end;
+    }
+
+    // One pattern character: one byte, or a code unit of `low` and `high` bytes.
+    Frag unit(const ByteSet& low, const ByteSet& high) {
+        if (encoding == TextEncoding::Ascii) return bytes(low);
+        Frag f = bytes(encoding == TextEncoding::Utf16LE ? low : high);
+        link(f, bytes(encoding == TextEncoding::Utf16LE ? high : low));
+        return f;
+    }
+
+    Frag build(const Node& n) {
+        if (overflow) return epsilon();
+
+        switch (n.kind) {
+        case Node::Set:
+            return unit(n.set, n.high);
+
+        case Node::Concat: {
+            Frag f = epsilon();
+            for (const auto& kid : n.kids) link(f, build(kid));
+            return f;
+        }
+
+        case Node::Alt: {
+            const Frag exit = epsilon();
+            int first = -1, split = -1;
+            for (std::size_t i = 0; i < n.kids.size(); ++i) {
+                Frag k = build(n.kids[i]);
+                states[static_cast<std::size_t>(k.end)].out = exit.start;
+                int entry = k.start;
+                if (i + 1 < n.kids.size()) {
+                    entry = add(Epsilon);
+                    states[static_cast<std::size_t>(entry)].out = k.start;
+                }
+                if (split >= 0) states[static_cast<std::size_t>(split)].out2 = entry;
+                else first = entry;
+                split = entry;
+            }
+            return {first, exit.end};
+        }
+
+        case Node::Repeat: {
+            Frag f = epsilon();
+            for (int i = 0; i < n.min && !overflow; ++i) link(f, build(n.kids[0]));
+
+            const Frag exit = epsilon();
+            if (n.max < 0) {
+                const int loop = add(Epsilon);
+                const Frag body = build(n.kids[0]);
+                states[static_cast<std::size_t>(loop)].out = body.start;
+                states[static_cast<std::size_t>(loop)].out2 = exit.start;
+                states[static_cast<std::size_t>(body.end)].out = loop;
+                states[static_cast<std::size_t>(f.end)].out = loop;
+                f.end = exit.end;
+                return f;
+            }
+            // Each optional copy may be skipped straight to the exit.
+            for (int i = n.min; i < n.max && !overflow; ++i) {
+                const int split = add(Epsilon);
+                link(f, {split, split});
+                const Frag body = build(n.kids[0]);
+                states[static_cast<std::size_t>(split)].out = body.start;
+                states[static_cast<std::size_t>(split)].out2 = exit.start;
+                f.end = body.end;
+            }
+            link(f, exit);
+            return f;
+        }
+        }
+        return epsilon();
+    }
+
+    // Byte and Match states reachable from `from` through epsilon moves, sorted.
+    std::vector<int> closure(const std::vector<int>& from, std::vector<char>& seen) const {
+        std::vector<int> out, stack(from);
+        std::vector<int> visited;
+        while (!stack.empty()) {
+            const int s = stack.back();
+            stack.pop_back();
+            if (s < 0 || seen[static_cast<std::size_t>(s)]) continue;
+            seen[static_cast<std::size_t>(s)] = 1;
+            visited.push_back(s);
+
+            const State& st = states[static_cast<std::size_t>(s)];
+            if (st.kind == Epsilon) {
+                stack.push_back(st.out2);
+                stack.push_back(st.out);
+            } else {
+                out.push_back(s);
+            }
+        }
+        for (int s : visited) seen[static_cast<std::size_t>(s)] = 0;
+        std::sort(out.begin(), out.end());
+        return out;
+    }
+};
+
+} // namespace
+
+bool TextSearch::compile(const std::string& pattern, const TextSearchOptions& opts, std::string& error) {
+    m_pattern.clear();
+    m_accept.clear();
+    m_next.clear();
+    m_prefix.clear();
+    m_first.fill(false);
+    if (pattern.empty()) { error = "empty pattern"; return false; }
+
+    // The pattern comes from a Gtk::Entry, so it is UTF-8. Byte mode searches for
+    // those bytes as they are; UTF-16 modes search for the characters they encode.
+    const bool wide = opts.encoding != TextEncoding::Ascii;
+    Node root{Node::Concat};
+    if (opts.regex) {
+        if (!Parser(pattern, opts.ignore_case, wide).parse(root, error)) return false;
+    } else if (wide) {
+        for (std::size_t pos = 0; pos < pattern.size();) {
+            std::uint32_t cp = 0;
+            if (!decode_utf8(pattern, pos, cp)) {
+                error = "invalid UTF-8 at position " + std::to_string(pos);
+                return false;
+            }
+            root.kids.push_back(code_point(cp, opts.ignore_case));
+        }
+    } else {
+        for (unsigned char c : pattern) {
+            Node n{Node::Set};
+            n.set.set(c);
+            if (opts.ignore_case) n.set = fold_case(n.set);
+            root.kids.push_back(std::move(n));
+        }
+    }
+
+    Nfa nfa;
+    nfa.encoding = opts.encoding;
+    Nfa::Frag whole = nfa.build(root);
+    nfa.link(whole, {nfa.add(Nfa::Match), -1});
+    nfa.start = whole.start;
+    if (nfa.overflow) { error = "pattern too large"; return false; }
+
+    // Bytes no set tells apart share a class, which keeps the table narrow.
+    std::array<int, 256> cls{};
+    int class_count = 1;
+    std::unordered_set<ByteSet> distinct(nfa.sets.begin(), nfa.sets.end());
+    for (const auto& s : distinct) {
+        std::map<std::pair<int, bool>, int> split;
+        for (std::size_t b = 0; b < 256; ++b) {
+            auto it = split.emplace(std::make_pair(cls[b], s[b]), static_cast<int>(split.size())).first;
+            cls[b] = it->second;
+        }
+        class_count = static_cast<int>(split.size());
+    }
+    const std::size_t C = static_cast<std::size_t>(class_count);
+    std::vector<int> representative(C, -1);
+    for (int b = 255; b >= 0; --b) representative[static_cast<std::size_t>(cls[static_cast<std::size_t>(b)])] = b;
+
+    // Subset construction, eagerly, so scans share a read-only table.
+    std::vector<char> seen(nfa.states.size(), 0);
+    std::map<std::vector<int>, std::uint32_t> ids;
+    std::vector<std::vector<int>> dstates;
+    dstates.emplace_back();
+    ids.emplace(dstates[0], 0);
+    dstates.push_back(nfa.closure({nfa.start}, seen));
+    ids.emplace(dstates[1], 1);
+
+    std::vector<std::uint32_t> next(2 * C, 0);
+    std::vector<int> moved;
+    for (std::size_t d = 1; d < dstates.size(); ++d) {
+        for (std::size_t c = 0; c < C; ++c) {
+            const auto b = static_cast<std::size_t>(representative[c]);
+            moved.clear();
+            for (int s : dstates[d]) {
+                const auto& st = nfa.states[static_cast<std::size_t>(s)];
+                if (st.kind == Nfa::Bytes && nfa.sets[static_cast<std::size_t>(st.set)][b]) moved.push_back(st.out);
+            }
+            std::vector<int> target = nfa.closure(moved, seen);
+            auto it = ids.find(target);
+            if (it == ids.end()) {
+                if (dstates.size() >= kMaxStates) { error = "pattern too complex"; return false; }
+                it = ids.emplace(target, static_cast<std::uint32_t>(dstates.size())).first;
+                dstates.push_back(std::move(target));
+                next.resize(dstates.size() * C, 0);
+            }
+            next[d * C + c] = it->second;
+        }
+    }
+
+    std::vector<char> accept(dstates.size(), 0);
+    for (std::size_t d = 0; d < dstates.size(); ++d)
+        for (int s : dstates[d])
+            if (nfa.states[static_cast<std::size_t>(s)].kind == Nfa::Match) accept[d] = 1;
+
+    // Shortest match, by breadth-first search from the start state. At most one step
+    // per DFA state, so it stays small.
+    std::vector<std::size_t> depth(dstates.size(), SIZE_MAX);
+    std::vector<std::uint32_t> queue{1};
+    depth[1] = 0;
+    std::size_t shortest = SIZE_MAX;
+    for (std::size_t q = 0; q < queue.size(); ++q) {
+        const std::uint32_t d = queue[q];
+        if (accept[d]) { shortest = depth[d]; break; }
+        for (std::size_t c = 0; c < C; ++c) {
+            const std::uint32_t t = next[d * C + c];
+            if (t == 0 || depth[t] != SIZE_MAX) continue;
+            depth[t] = depth[d] + 1;
+            queue.push_back(t);
+        }
+    }
+    if (shortest == SIZE_MAX) { error = "pattern can never match"; return false; }
+
+    std::array<bool, 256> first{};
+    bool any = false;
+    for (std::size_t b = 0; b < 256; ++b) {
+        first[b] = next[C + static_cast<std::size_t>(cls[b])] != 0;
+        any = any || first[b];
+    }
+    if (!any) { error = "pattern only matches the empty string"; return false; }
+
+    // Follow the start state while exactly one byte leads on: those bytes are a
+    // prefix every match shares.
+    std::vector<unsigned char> prefix;
+    for (std::uint32_t s = 1; !accept[s] && prefix.size() < kMaxPrefix;) {
+        int only = -1;
+        for (std::size_t c = 0; c < C; ++c) {
+            if (next[s * C + c] == 0) continue;
+            if (only >= 0) { only = -2; break; }
+            only = static_cast<int>(c);
+        }
+        if (only < 0) break;
+        int byte = -1, members = 0;
+        for (std::size_t b = 0; b < 256; ++b)
+            if (cls[b] == only) { byte = static_cast<int>(b); ++members; }
+        if (members != 1) break;
+        prefix.push_back(static_cast<unsigned char>(byte));
+        s = next[s * C + static_cast<std::size_t>(only)];
+    }
+
+    m_pattern = pattern;
+    m_opts = opts;
+    // A cap below the shortest match would make every match unreachable.
+    m_opts.max_match = std::max<std::size_t>({1, opts.max_match, shortest});
+    for (std::size_t b = 0; b < 256; ++b) m_class[b] = static_cast<std::uint8_t>(cls[b]);
+    m_class_count = C;
+    m_next = std::move(next);
+    m_accept = std::move(accept);
+    m_first = first;
+    m_prefix = std::move(prefix);
+    // Zero bytes are everywhere in binaries; memchr for the first non-zero one.
+    m_anchor = 0;
+    while (m_anchor + 1 < m_prefix.size() && m_prefix[m_anchor] == 0) ++m_anchor;
+    error.clear();
+    return true;
+}
+
+std::vector<unsigned char> TextSearch::key() const {
+    const auto max = static_cast<std::uint32_t>(std::min<std::size_t>(m_opts.max_match, UINT32_MAX));
+    std::vector<unsigned char> k(9 + m_pattern.size());
+    k[0] = 'T';
+    k[1] = 'S';
+    k[2] = kKeyVersion;
+    k[3] = static_cast<unsigned char>((m_opts.regex ? 1 : 0) | (m_opts.ignore_case ? 2 : 0));
+    k[4] = static_cast<unsigned char>(m_opts.encoding);
+    for (int i = 0; i < 4; ++i) k[5 + static_cast<std::size_t>(i)] = static_cast<unsigned char>(max >> (8 * i));
+    std::copy(m_pattern.begin(), m_pattern.end(), k.begin() + 9);
+    return k;
+}
+
+bool TextSearch::compile_key(const std::vector<unsigned char>& key) {
+    if (key.size() < 10 || key[0] != 'T' || key[1] != 'S' || key[2] != kKeyVersion || key[4] > 2) return false;
+
+    TextSearchOptions opts;
+    opts.regex = (key[3] & 1) != 0;
+    opts.ignore_case = (key[3] & 2) != 0;
+    opts.encoding = static_cast<TextEncoding>(key[4]);
+    opts.max_match = static_cast<std::size_t>(key[5]) | static_cast<std::size_t>(key[6]) << 8 |
+                     static_cast<std::size_t>(key[7]) << 16 | static_cast<std::size_t>(key[8]) << 24;
+
+    std::string error;
+    return compile(std::string(key.begin() + 9, key.end()), opts, error);
+}
+
+std::size_t TextSearch::match_at(const unsigned char* data, std::size_t n, std::size_t offset) const {
+    if (!valid() || offset >= n) return 0;
+    const std::size_t end = offset + std::min(m_opts.max_match, n - offset);
+    const std::size_t C = m_class_count;
+
+    std::size_t best = 0;
+    std::uint32_t s = 1;
+    for (std::size_t i = offset; i < end; ++i) {
+        s = m_next[s * C + m_class[data[i]]];
+        if (s == 0) break;
+        if (m_accept[s]) best = i - offset + 1;
+    }
+    return best;
+}
+
+bool TextSearch::next(const unsigned char* data, std::size_t n, std::size_t pos, std::size_t limit,
+                      std::size_t& offset, std::size_t& length) const {
+    if (!valid()) return false;
+    limit = std::min(limit, n);
+
+    if (!m_prefix.empty()) {
+        const std::size_t m = m_prefix.size();
+        const std::size_t a = m_anchor;
+        const std::size_t stop = std::min(n, limit + a);
+        while (pos < limit && pos + a < stop) {
+            const void* hit = std::memchr(data + pos + a, m_prefix[a], stop - pos - a);
+            if (!hit) return false;
+            const std::size_t p = static_cast<std::size_t>(static_cast<const unsigned char*>(hit) - data) - a;
+            if (p + m <= n && std::memcmp(data + p, m_prefix.data(), m) == 0) {
+                if (const std::size_t len = match_at(data, n, p)) {
+                    offset = p;
+                    length = len;
+                    return true;
+                }
+            }
+            pos = p + 1;
+        }
+        return false;
+    }
+
+    for (; pos < limit; ++pos) {
+        if (!m_first[data[pos]]) continue;
+        if (const std::size_t len = match_at(data, n, pos)) {
+            offset = pos;
+            length = len;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::size_t TextSearch::resync(const unsigned char* data, std::size_t n, std::size_t& pos,
+                               std::size_t limit, std::size_t sync_from,
+                               const std::vector<std::size_t>& expected, std::size_t k,
+                               std::vector<std::size_t>& out) const {
+    std::size_t off = 0, len = 0;
+    while (next(data, n, pos, limit, off, len)) {
+        if (off >= sync_from) {
+            auto it = std::lower_bound(expected.begin() + static_cast<long>(k), expected.end(), off);
+            if (it != expected.end() && *it == off) return static_cast<std::size_t>(it - expected.begin());
+        }
+        out.push_back(off);
+        pos = off + len;
+    }
+    return expected.size();
+}
+
+void TextSearch::find(const unsigned char* data, std::size_t n, const BatchCallback& on_batch,
+                      const std::atomic<bool>* cancel) const {
+    if (!valid() || n == 0 || !on_batch) return;
+
+    const std::size_t chunk = std::max<std::size_t>(m_opts.chunk_size, 64u << 10);
+    const std::size_t nchunks = (n + chunk - 1) / chunk;
+
+    std::vector<std::vector<std::size_t>> results(nchunks);
+    std::vector<char> ready(nchunks, 0);
+    std::mutex mu;
+    std::size_t emitted = 0;
+    std::size_t pos = 0;   // end of the last delivered match
+
+    auto cancelled = [cancel] { return cancel && cancel->load(std::memory_order_relaxed); };
+
+    WorkerPool::shared().parallel_for(nchunks, [&](std::size_t k) {
+        if (cancelled()) return;
+
+        std::vector<std::size_t> local;
+        const std::size_t hi = std::min(n, (k + 1) * chunk);
+        std::size_t p = k * chunk, off = 0, len = 0;
+        while (next(data, n, p, hi, off, len)) {
+            local.push_back(off);
+            p = off + len;
+        }
+
+        std::lock_guard<std::mutex> lock(mu);
+        results[k] = std::move(local);
+        ready[k] = 1;
+        while (emitted < nchunks && ready[emitted]) {
+            auto& r = results[emitted];
+            std::vector<std::size_t> batch;
+            if (r.empty() || r.front() >= pos) {
+                batch = std::move(r);
+            } else {
+                // The previous chunk's last match ran into this one.
+                const std::size_t e_hi = std::min(n, (emitted + 1) * chunk);
+                const std::size_t j = resync(data, n, pos, e_hi, pos, r, 0, batch);
+                batch.insert(batch.end(), r.begin() + static_cast<long>(j), r.end());
+            }
+            if (!batch.empty()) pos = batch.back() + match_at(data, n, batch.back());
+            if (!cancelled()) on_batch(std::move(batch));
+            results[emitted] = std::vector<std::size_t>();
+            ++emitted;
+        }
+    });
+}
+
+void TextSearch::repair(const unsigned char* data, std::size_t n,
+                        const std::vector<std::pair<std::size_t, std::size_t>>& changed,
+                        std::vector<std::size_t>& hits) const {
+    if (!valid()) return;
+
+    std::vector<std::size_t> out;
+    out.reserve(hits.size());
+    std::size_t pos = 0, k = 0;
+
+    // Old hits starting before `upto` read no changed byte and are kept as they are.
+    auto keep = [&](std::size_t upto) {
+        const std::size_t before = out.size();
+        for (; k < hits.size() && hits[k] < upto; ++k)
+            if (hits[k] >= pos) out.push_back(hits[k]);
+        if (out.size() > before) pos = out.back() + match_at(data, n, out.back());
+    };
+
+    for (const auto& [begin, end] : changed) {
+        const std::size_t lo = begin >= m_opts.max_match ? begin - m_opts.max_match + 1 : 0;
+        keep(lo);
+        pos = std::max(pos, lo);
+        k = resync(data, n, pos, n, end, hits, k, out);
+    }
+    keep(n);
+    hits = std::move(out);
+}
@@ -0,0 +1,202 @@
+#include "ValueDecoder.hpp"
+#include <cinttypes>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+namespace {
+
+using Text = std::array<char, ValueDecoder::kTextLen>;
+
+void put(Text& t, const char* s) {
+    std::snprintf(t.data(), t.size(), "%s", s);
+}
+
+std::uint64_t read_uint(const unsigned char* p, std::size_t size, bool big_endian) {
+    std::uint64_t v = 0;
+    if (big_endian) {
+        for (std::size_t i = 0; i < size; ++i) v = (v << 8) | p[i];
+    } else {
+        for (std::size_t i = size; i-- > 0;) v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+std::int64_t sign_extend(std::uint64_t v, std::size_t size) {
+    const int shift = static_cast<int>(64 - size * 8);
+    return static_cast<std::int64_t>(v << shift) >> shift;
+}
+
+float half_to_float(std::uint16_t h) {
+    const unsigned exp = (h >> 10) & 0x1Fu;
+    const unsigned mant = h & 0x3FFu;
+    float v;
+    if (exp == 0) v = std::ldexp(static_cast<float>(mant), -24);
+    else if (exp == 31) v = mant ? NAN : INFINITY;
+    else v = std::ldexp(static_cast<float>(mant | 0x400u), static_cast<int>(exp) - 25);
+    return (h & 0x8000u) ? -v : v;
+}
+
+void format_time(Text& t, std::int64_t secs) {
+    std::tm tm{};
+    const std::time_t tt = static_cast<std::time_t>(secs);
+    if (static_cast<std::int64_t>(tt) != secs || !gmtime_r(&tt, &tm)) { put(t, "invalid"); return; }
+    if (std::strftime(t.data(), t.size(), "%Y-%m-%d %H:%M:%S UTC", &tm) == 0) put(t, "invalid");
+}
+
+// Appends the UTF-8 encoding of a printable code point after "U+XXXX ".
+void format_code_point(Text& t, std::uint32_t cp, std::size_t units) {
+    int w = std::snprintf(t.data(), t.size(), "U+%04" PRIX32, cp);
+    if (w < 0) return;
+    std::size_t o = static_cast<std::size_t>(w);
+    const bool printable = cp >= 0x20 && cp != 0x7F && !(cp >= 0x80 && cp < 0xA0) &&
+                           !(cp >= 0xD800 && cp <= 0xDFFF) && cp <= 0x10FFFF;
+    if (printable && o + 8 < t.size()) {
+        t[o++] = ' ';
+        t[o++] = '\'';
+        if (cp < 0x80) {
+            t[o++] = static_cast<char>(cp);
+        } else if (cp < 0x800) {
+            t[o++] = static_cast<char>(0xC0 | (cp >> 6));
+            t[o++] = static_cast<char>(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            t[o++] = static_cast<char>(0xE0 | (cp >> 12));
+            t[o++] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            t[o++] = static_cast<char>(0x80 | (cp & 0x3F));
+        } else {
+            t[o++] = static_cast<char>(0xF0 | (cp >> 18));
+            t[o++] = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+            t[o++] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            t[o++] = static_cast<char>(0x80 | (cp & 0x3F));
+        }
+        t[o++] = '\'';
+    }
+    std::snprintf(t.data() + o, t.size() - o, " (%zu B)", units);
+}
+
+void decode_utf8(Text& t, const unsigned char* p, std::size_t avail) {
+    const unsigned char b0 = p[0];
+    std::size_t len = 0;
+    std::uint32_t cp = 0;
+    if (b0 < 0x80) { len = 1; cp = b0; }
+    else if ((b0 & 0xE0) == 0xC0) { len = 2; cp = b0 & 0x1Fu; }
+    else if ((b0 & 0xF0) == 0xE0) { len = 3; cp = b0 & 0x0Fu; }
+    else if ((b0 & 0xF8) == 0xF0) { len = 4; cp = b0 & 0x07u; }
+    else { put(t, "invalid"); return; }
+
+    if (len > avail) { put(t, "truncated"); return; }
+    for (std::size_t i = 1; i < len; ++i) {
+        if ((p[i] & 0xC0) != 0x80) { put(t, "invalid"); return; }
+        cp = (cp << 6) | (p[i] & 0x3Fu);
+    }
+    // Reject overlong forms and out-of-range values.
+    static const std::uint32_t kMin[5] = {0, 0, 0x80, 0x800, 0x10000};
+    if (cp < kMin[len] || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) { put(t, "invalid"); return; }
+    format_code_point(t, cp, len);
+}
+
+void decode_utf16(Text& t, const unsigned char* p, std::size_t avail, bool big_endian) {
+    if (avail < 2) { put(t, "-"); return; }
+    const std::uint32_t u0 = static_cast<std::uint32_t>(read_uint(p, 2, big_endian));
+    if (u0 >= 0xD800 && u0 <= 0xDBFF) {
+        if (avail < 4) { put(t, "truncated"); return; }
+        const std::uint32_t u1 = static_cast<std::uint32_t>(read_uint(p + 2, 2, big_endian));
+        if (u1 < 0xDC00 || u1 > 0xDFFF) { put(t, "invalid"); return; }
+        format_code_point(t, 0x10000 + ((u0 - 0xD800) << 10) + (u1 - 0xDC00), 4);
+        return;
+    }
+    if (u0 >= 0xDC00 && u0 <= 0xDFFF) { put(t, "invalid"); return; }
+    format_code_point(t, u0, 2);
+}
+
+bool decode_leb128(const unsigned char* p, std::size_t avail, bool is_signed,
+                   std::uint64_t& value, std::size_t& used) {
+    value = 0;
+    unsigned shift = 0;
+    for (used = 0; used < avail && used < 10; ++used) {
+        const unsigned char b = p[used];
+        value |= static_cast<std::uint64_t>(b & 0x7F) << shift;
+        shift += 7;
+        if (!(b & 0x80)) {
+            ++used;
+            if (is_signed && shift < 64 && (b & 0x40)) value |= ~0ull << shift;
+            return true;
+        }
+    }
+    return false;
+}
+
+void format_guid(Text& t, const unsigned char* p, bool big_endian) {
+    const auto d1 = static_cast<std::uint32_t>(read_uint(p, 4, big_endian));
+    const auto d2 = static_cast<unsigned>(read_uint(p + 4, 2, big_endian));
+    const auto d3 = static_cast<unsigned>(read_uint(p + 6, 2, big_endian));
+    std::snprintf(t.data(), t.size(), "{%08" PRIX32 "-%04X-%04X-%02X%02X-%02X%02X%02X%02X%02X%02X}",
+                  d1, d2, d3, p[8], p[9], p[10], p[11], p[12], p[13], p[14], p[15]);
+}
+
+} // namespace
+
+const char* ValueDecoder::row_label(Row row) {
+    static const char* kLabels[kRowCount] = {
+        "int8", "uint8", "int16", "uint16", "int32", "uint32", "int64", "uint64",
+        "float16", "float32", "float64", "ULEB128", "SLEB128", "time32 (UTC)", "time64 (UTC)",
+        "GUID", "UTF-8", "UTF-16", "binary",
+    };
+    return (row >= 0 && row < kRowCount) ? kLabels[row] : "";
+}
+
+void ValueDecoder::decode(const unsigned char* data, std::size_t n, std::size_t offset, Values& out) {
+    const std::size_t avail = offset < n ? n - offset : 0;
+    const unsigned char* p = data + (offset < n ? offset : 0);
+
+    for (int order = 0; order < 2; ++order) {
+        const bool big = order == 1;
+        auto& col = big ? out.big : out.little;
+        for (auto& t : col) put(t, "-");
+        if (avail == 0) continue;
+
+        static const std::size_t kIntSizes[4] = {1, 2, 4, 8};
+        for (int i = 0; i < 4; ++i) {
+            const std::size_t size = kIntSizes[i];
+            if (avail < size) break;
+            const std::uint64_t u = read_uint(p, size, big);
+            std::snprintf(col[Int8 + i * 2].data(), kTextLen, "%" PRId64, sign_extend(u, size));
+            std::snprintf(col[UInt8 + i * 2].data(), kTextLen, "%" PRIu64, u);
+        }
+
+        if (avail >= 2)
+            std::snprintf(col[Half].data(), kTextLen, "%g",
+                          static_cast<double>(half_to_float(static_cast<std::uint16_t>(read_uint(p, 2, big)))));
+        if (avail >= 4) {
+            const auto bits = static_cast<std::uint32_t>(read_uint(p, 4, big));
+            float f;
+            std::memcpy(&f, &bits, sizeof(f));
+            std::snprintf(col[Float].data(), kTextLen, "%.9g", static_cast<double>(f));
+            format_time(col[Time32], static_cast<std::int32_t>(bits));
+        }
+        if (avail >= 8) {
+            const std::uint64_t bits = read_uint(p, 8, big);
+            double d;
+            std::memcpy(&d, &bits, sizeof(d));
+            std::snprintf(col[Double].data(), kTextLen, "%.17g", d);
+            format_time(col[Time64], static_cast<std::int64_t>(bits));
+        }
+        if (avail >= 16) format_guid(col[Guid], p, big);
+
+        // Byte-order independent encodings show the same value in both columns.
+        std::uint64_t leb = 0;
+        std::size_t used = 0;
+        if (decode_leb128(p, avail, false, leb, used))
+            std::snprintf(col[ULeb128].data(), kTextLen, "%" PRIu64 " (%zu B)", leb, used);
+        if (decode_leb128(p, avail, true, leb, used))
+            std::snprintf(col[SLeb128].data(), kTextLen, "%" PRId64 " (%zu B)", static_cast<std::int64_t>(leb), used);
+        decode_utf8(col[Utf8], p, avail);
+        decode_utf16(col[Utf16], p, avail, big);
+
+        char* bin = col[Binary].data();
+        for (int b = 0; b < 8; ++b) bin[b] = (p[0] & (0x80 >> b)) ? '1' : '0';
+        bin[8] = '\0';
+    }
+}
@@ -0,0 +1,86 @@
+#include "WorkerPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+WorkerPool& WorkerPool::shared() {
+    static WorkerPool pool;
+    return pool;
+}
+
+WorkerPool::WorkerPool(unsigned threads) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    m_threads.reserve(threads);
+    for (unsigned t = 0; t < threads; ++t) m_threads.emplace_back(&WorkerPool::run, this);
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_cv.notify_all();
+    for (auto& th : m_threads) th.join();
+}
+
+std::future<void> WorkerPool::submit(std::function<void()> job) {
+    auto task = std::make_shared<std::packaged_task<void()>>(std::move(job));
+    auto result = task->get_future();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.emplace_back([task] { (*task)(); });
+    }
+    m_cv.notify_one();
+    return result;
+}
+
+void WorkerPool::run() {
+    for (;;) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+            if (m_queue.empty()) return;
+            job = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+        job();
+    }
+}
+
+void WorkerPool::parallel_for(std::size_t count, const std::function<void(std::size_t)>& fn) {
+    if (count == 0) return;
+
+    // Helpers that start after every index is claimed only touch this shared state,
+    // never `fn`, so the caller may return as soon as the last claimed call finishes.
+    struct State {
+        std::atomic<std::size_t> next{0};
+        std::size_t done{0};
+        std::mutex mutex;
+        std::condition_variable cv;
+    };
+    auto state = std::make_shared<State>();
+    const std::function<void(std::size_t)>* body = &fn;
+
+    auto drain = [state, body, count] {
+        std::size_t finished = 0;
+        for (std::size_t i; (i = state->next.fetch_add(1)) < count; ++finished) (*body)(i);
+        if (finished == 0) return;
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->done += finished;
+        if (state->done == count) state->cv.notify_all();
+    };
+
+    const std::size_t helpers = std::min<std::size_t>(m_threads.size(), count - 1);
+    if (helpers > 0) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (std::size_t h = 0; h < helpers; ++h) m_queue.emplace_back(drain);
+        }
+        m_cv.notify_all();
+    }
+
+    drain();
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->cv.wait(lock, [&] { return state->done == count; });
+}
@@ -40,13 +40,31 @@ std::vector<Menu> buildHexEditorMenus() {
             { "", nullptr, true },
             { "Little Endian", []{ notImplemented("Little Endian"); } },
             { "Big Endian", []{ notImplemented("Big Endian"); } },
+            { "", nullptr, true },
+            { "8 Bytes per Row", []{ /* Handled by MainWindow override */ } },
+            { "16 Bytes per Row", []{ /* Handled by MainWindow override */ } },
+            { "32 Bytes per Row", []{ /* Handled by MainWindow override */ } },
+            { "64 Bytes per Row", []{ /* Handled by MainWindow override */ } },
+            { "Group by 1 Byte", []{ /* Handled by MainWindow override */ } },
+            { "Group by 2 Bytes", []{ /* Handled by MainWindow override */ } },
+            { "Group by 4 Bytes", []{ /* Handled by MainWindow override */ } },
+            { "Group by 8 Bytes", []{ /* Handled by MainWindow override */ } },
+            { "", nullptr, true },
+            { "Data Inspector", []{ /* Handled by MainWindow override */ } },
         }},
 
         { "Search", {
             { "Find Bytes...", []{ notImplemented("Find Bytes"); } },
-            { "Find ASCII...", []{ notImplemented("Find ASCII"); } },
+            { "Find Text...", []{ notImplemented("Find Text"); } },
             { "Find Hex Pattern...", []{ notImplemented("Find Hex Pattern"); } },
-            { "Go To Offset...", []{ notImplemented("Go To Offset"); } },
+            { "Go To Offset...", []{ /* Handled by MainWindow override */ } },
+            { "", nullptr, true },
+            { "Add Bookmark...", []{ /* Handled by MainWindow override */ } },
+            { "Next Bookmark", []{ /* Handled by MainWindow override */ } },
+            { "Previous Bookmark", []{ /* Handled by MainWindow override */ } },
+            { "Highlight Selection", []{ /* Handled by MainWindow override */ } },
+            { "Clear Highlights", []{ /* Handled by MainWindow override */ } },
+            { "Clear Search Marks", []{ /* Handled by MainWindow override */ } },
         }},
 
         { "Analysis", {
@@ -54,6 +72,9 @@ std::vector<Menu> buildHexEditorMenus() {
             { "Entropy", []{ notImplemented("Entropy"); } },
             { "CRC32", []{ notImplemented("CRC32"); } },
             { "SHA-256", []{ notImplemented("SHA-256"); } },
+            { "", nullptr, true },
+            { "Strings...", []{ /* Handled by MainWindow override */ } },
+            { "Structure Template...", []{ /* Handled by MainWindow override */ } },
         }},
 
         { "Help", {